@@ -3,8 +3,14 @@
 #include <cassert>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+#include <string>
+#include <vector>
 #include "FreeImagePlus.h"
 #include "Stopwatch.h"
+#include "ImageView.h"
+#include "ImageBuffer.h"
+#include "ImageIO.h"
 
 using namespace std;
 
@@ -24,14 +30,114 @@ typedef struct tagRGBQUAD {
 #endif
 
 ////////////////////////////////////////////////////////////////////////
+// integer square root table for all squared magnitudes below 255^2: removes sqrt from the hot loops
+class SqrtLUT {
+	static const int Size = 255*255 + 1;
+	BYTE m_table[Size];
+
+public:
+	SqrtLUT() {
+		int d = 0;
+		for (int i = 0; i < Size; i++) {
+			if ((d + 1)*(d + 1) <= i) d++;
+			m_table[i] = (BYTE)d;
+		}
+	}
+	BYTE operator()(int d2) const {
+		return m_table[(d2 < Size) ? d2 : Size - 1];
+	}
+};
+
+static const SqrtLUT s_sqrtLUT;
+
+////////////////////////////////////////////////////////////////////////
+// same result as min((int)sqrt(x*x + y*y), 255)
 static BYTE dist(int x, int y) {
-	int d = (int)sqrt(x*x + y*y);
-	return (d < 256) ? d : 255;
+	return s_sqrtLUT(x*x + y*y);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Border handling
+// Skip leaves the outer fSize/2 pixels untouched, Clamp corresponds to CL_ADDRESS_CLAMP_TO_EDGE,
+// Mirror reflects at the edge (edge pixel repeated), Wrap repeats the image and Zero treats outside pixels as black
+enum class BorderMode { Skip, Clamp, Mirror, Wrap, Zero };
+
+////////////////////////////////////////////////////////////////////////
+// maps coordinate i to [0,n) according to the border mode; returns -1 if the pixel has to be treated as zero
+static int borderIndex(int i, int n, BorderMode border) {
+	if (i >= 0 && i < n) return i;
+
+	switch(border) {
+	case BorderMode::Clamp:
+		return (i < 0) ? 0 : n - 1;
+	case BorderMode::Mirror:
+		do {
+			i = (i < 0) ? -i - 1 : 2*n - i - 1;
+		} while(i < 0 || i >= n);
+		return i;
+	case BorderMode::Wrap:
+		i %= n;
+		return (i < 0) ? i + n : i;
+	default:
+		return -1;
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////
-static void processSerial(const fipImage& input, fipImage& output) {
-	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getImageSize() == output.getImageSize());
+// slow path for the border strips of width fSize/2 which are skipped by the fast interior loops
+template<int fSize>
+static void processBorder(const fipImage& input, fipImage& output, const int (&hFilter)[fSize][fSize], const int (&vFilter)[fSize][fSize], BorderMode border, bool parallel) {
+	const int fSize2 = fSize / 2;
+	const int w = input.getWidth();
+	const int h = input.getHeight();
+	const int left = min(fSize2, w);
+	const int right = max(w - fSize2, left);
+
+	if (border == BorderMode::Skip) return;
+
+	const ConstBGRAView in(input);
+	const BGRAView out(output);
+
+#pragma omp parallel for if(parallel)
+	for (int v = 0; v < h; v++) {
+		const bool interiorRow = v >= fSize2 && v < h - fSize2;
+
+		for (int u = 0; u < w; u++) {
+			if (interiorRow && u == left) u = right;	// jump over the interior
+			if (u == w) break;
+
+			int hC[3] = { 0, 0, 0 };
+			int vC[3] = { 0, 0, 0 };
+
+			for (int j = 0; j < fSize; j++) {
+				const int y = borderIndex(v + j - fSize2, h, border);
+
+				for (int i = 0; i < fSize; i++) {
+					const int x = borderIndex(u + i - fSize2, w, border);
+
+					if (x >= 0 && y >= 0) {
+						const BYTE *iC = in(x, y);
+						hC[0] += hFilter[j][i] * iC[0];
+						vC[0] += vFilter[j][i] * iC[0];
+						hC[1] += hFilter[j][i] * iC[1];
+						vC[1] += vFilter[j][i] * iC[1];
+						hC[2] += hFilter[j][i] * iC[2];
+						vC[2] += vFilter[j][i] * iC[2];
+					}
+				}
+			}
+			BYTE *oC = out(u, v);
+			oC[0] = dist(hC[0], vC[0]);
+			oC[1] = dist(hC[1], vC[1]);
+			oC[2] = dist(hC[2], vC[2]);
+			oC[3] = 255;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+static void processSerial(const fipImage& input, fipImage& output, BorderMode border) {
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
 	assert(input.getBitsPerPixel() == 32);
 
 	const int fSize = 3;
@@ -47,37 +153,43 @@ static void processSerial(const fipImage& input, fipImage& output) {
 		{ 1, 0,-1 }
 	};
 
+	const ConstBGRAView in(input);
+	const BGRAView out(output);
 
-	for (unsigned int v = fSize2; v < output.getHeight() - fSize2; v++) {
-		for (unsigned int u = fSize2; u < output.getWidth() - fSize2; u++) {
-			RGBQUAD iC;
+	// naive: every neighbour is addressed by its coordinates
+	for (int v = fSize2; v < out.getHeight() - fSize2; v++) {
+		for (int u = fSize2; u < out.getWidth() - fSize2; u++) {
 			int hC[3] = { 0, 0, 0 };
 			int vC[3] = { 0, 0, 0 };
 
-			for (unsigned int j = 0; j < fSize; j++) {
-				for (unsigned int i = 0; i < fSize; i++) {
-					input.getPixelColor(u + i - fSize2, v + j - fSize2, &iC);
-					hC[0] += hFilter[j][i] * iC.rgbBlue;
-					vC[0] += vFilter[j][i] * iC.rgbBlue;
-					hC[1] += hFilter[j][i] * iC.rgbGreen;
-					vC[1] += vFilter[j][i] * iC.rgbGreen;
-					hC[2] += hFilter[j][i] * iC.rgbRed;
-					vC[2] += vFilter[j][i] * iC.rgbRed;
+			for (int j = 0; j < fSize; j++) {
+				for (int i = 0; i < fSize; i++) {
+					const BYTE *iC = in(u + i - fSize2, v + j - fSize2);
+					hC[0] += hFilter[j][i] * iC[0];
+					vC[0] += vFilter[j][i] * iC[0];
+					hC[1] += hFilter[j][i] * iC[1];
+					vC[1] += vFilter[j][i] * iC[1];
+					hC[2] += hFilter[j][i] * iC[2];
+					vC[2] += vFilter[j][i] * iC[2];
 				}
 			}
-			RGBQUAD oC = { dist(hC[0], vC[0]), dist(hC[1], vC[1]), dist(hC[2], vC[2]), 255 };
-			output.setPixelColor(u, v, &oC);
+			BYTE *oC = out(u, v);
+			oC[0] = dist(hC[0], vC[0]);
+			oC[1] = dist(hC[1], vC[1]);
+			oC[2] = dist(hC[2], vC[2]);
+			oC[3] = 255;
 		}
 	}
+
+	processBorder(input, output, hFilter, vFilter, border, false);
 }
 
 ////////////////////////////////////////////////////////////////////////
-static void processSerialOpt(const fipImage& input, fipImage& output) {
+static void processSerialOpt(const fipImage& input, fipImage& output, BorderMode border) {
 	const int bypp = 4;
-	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getImageSize() == output.getImageSize());
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
 	assert(input.getBitsPerPixel() == bypp * 8);
 
-	const size_t stride = input.getScanWidth();
 	const int fSize = 3;
 	const int fSize2 = fSize / 2;
 	const int hFilter[][fSize] = {
@@ -91,51 +203,47 @@ static void processSerialOpt(const fipImage& input, fipImage& output) {
 		{ 1, 0,-1 }
 	};
 
-	BYTE *iRow = input.getScanLine(fSize2) + bypp * fSize2;
-	BYTE *oRow = output.getScanLine(fSize2) + bypp * fSize2;
+	const ConstBGRAView in(input);
+	const BGRAView out(output);
 
-	for (size_t v = fSize2; v < output.getHeight() - fSize2; v++) {
-		BYTE *iCenter = iRow;
-		BYTE *oPos = oRow;
+	// the filter window slides along the row
+	for (int v = fSize2; v < out.getHeight() - fSize2; v++) {
+		ConstBGRAView::Window win = in.window(fSize2, v);
+		BYTE *oC = out(fSize2, v);
 
-		for (size_t u = fSize2; u < output.getWidth() - fSize2; u++) {
+		for (int u = fSize2; u < out.getWidth() - fSize2; u++) {
 			int hC[3] = { 0, 0, 0 };
 			int vC[3] = { 0, 0, 0 };
 
-			BYTE *iPos = iCenter - fSize2 * stride - bypp * fSize2;
-			for (size_t j = 0; j < fSize; j++) {
-				for (size_t i = 0; i < fSize; i++) {
-					RGBQUAD *iC = reinterpret_cast<RGBQUAD*>(iPos);
-					hC[0] += hFilter[j][i] * iC->rgbBlue;
-					vC[0] += vFilter[j][i] * iC->rgbBlue;
-					hC[1] += hFilter[j][i] * iC->rgbGreen;
-					vC[1] += vFilter[j][i] * iC->rgbGreen;
-					hC[2] += hFilter[j][i] * iC->rgbRed;
-					vC[2] += vFilter[j][i] * iC->rgbRed;
-					iPos += bypp;
+			for (int j = 0; j < fSize; j++) {
+				for (int i = 0; i < fSize; i++) {
+					const BYTE *iC = win(i - fSize2, j - fSize2);
+					hC[0] += hFilter[j][i] * iC[0];
+					vC[0] += vFilter[j][i] * iC[0];
+					hC[1] += hFilter[j][i] * iC[1];
+					vC[1] += vFilter[j][i] * iC[1];
+					hC[2] += hFilter[j][i] * iC[2];
+					vC[2] += vFilter[j][i] * iC[2];
 				}
-				iPos += stride - bypp * fSize;
 			}
-			RGBQUAD *oC = reinterpret_cast<RGBQUAD*>(oPos);
-			oC->rgbBlue = dist(hC[0], vC[0]);
-			oC->rgbGreen = dist(hC[1], vC[1]);
-			oC->rgbRed = dist(hC[2], vC[2]);
-			oC->rgbReserved = 255;
-			iCenter += bypp;
-			oPos += bypp;
+			oC[0] = dist(hC[0], vC[0]);
+			oC[1] = dist(hC[1], vC[1]);
+			oC[2] = dist(hC[2], vC[2]);
+			oC[3] = 255;
+			win.moveRight();
+			oC += ConstBGRAView::Channels;
 		}
-		iRow += stride;
-		oRow += stride;
 	}
+
+	processBorder(input, output, hFilter, vFilter, border, false);
 }
 
 ////////////////////////////////////////////////////////////////////////
-static void processParallel(const fipImage& input, fipImage& output) {
+static void processParallel(const fipImage& input, fipImage& output, BorderMode border) {
 	const int bypp = 4;
-	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getImageSize() == output.getImageSize());
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
 	assert(input.getBitsPerPixel() == bypp * 8);
 
-	const size_t stride = input.getScanWidth();
 	const int fSize = 3;
 	const int fSize2 = fSize / 2;
 	const int hFilter[][fSize] = {
@@ -149,44 +257,44 @@ static void processParallel(const fipImage& input, fipImage& output) {
 		{ 1, 0,-1 }
 	};
 
+	const ConstBGRAView in(input);
+	const BGRAView out(output);
 
-#pragma omp parallel for default(none)
-	for (int v = fSize2; v < (int)output.getHeight() - fSize2; v++) {
-		BYTE *iCenter = input.getScanLine(v) + bypp * fSize2;
-		BYTE *oPos = output.getScanLine(v) + bypp * fSize2;
+#pragma omp parallel for default(none) shared(in, out, hFilter, vFilter)
+	for (int v = fSize2; v < out.getHeight() - fSize2; v++) {
+		ConstBGRAView::Window win = in.window(fSize2, v);
+		BYTE *oC = out(fSize2, v);
 
-		for (size_t u = fSize2; u < output.getWidth() - fSize2; u++) {
+		for (int u = fSize2; u < out.getWidth() - fSize2; u++) {
 			int hC[3] = { 0, 0, 0 };
 			int vC[3] = { 0, 0, 0 };
 
-			BYTE *iPos = iCenter - fSize2 * stride - bypp * fSize2;
-			for (size_t j = 0; j < fSize; j++) {
-				for (size_t i = 0; i < fSize; i++) {
-					RGBQUAD *iC = reinterpret_cast<RGBQUAD*>(iPos);
-					hC[0] += hFilter[j][i] * iC->rgbBlue;
-					vC[0] += vFilter[j][i] * iC->rgbBlue;
-					hC[1] += hFilter[j][i] * iC->rgbGreen;
-					vC[1] += vFilter[j][i] * iC->rgbGreen;
-					hC[2] += hFilter[j][i] * iC->rgbRed;
-					vC[2] += vFilter[j][i] * iC->rgbRed;
-					iPos += bypp;
+			for (int j = 0; j < fSize; j++) {
+				for (int i = 0; i < fSize; i++) {
+					const BYTE *iC = win(i - fSize2, j - fSize2);
+					hC[0] += hFilter[j][i] * iC[0];
+					vC[0] += vFilter[j][i] * iC[0];
+					hC[1] += hFilter[j][i] * iC[1];
+					vC[1] += vFilter[j][i] * iC[1];
+					hC[2] += hFilter[j][i] * iC[2];
+					vC[2] += vFilter[j][i] * iC[2];
 				}
-				iPos += stride - bypp * fSize;
 			}
-			RGBQUAD *oC = reinterpret_cast<RGBQUAD*>(oPos);
-			oC->rgbBlue = dist(hC[0], vC[0]);
-			oC->rgbGreen = dist(hC[1], vC[1]);
-			oC->rgbRed = dist(hC[2], vC[2]);
-			oC->rgbReserved = 255;
-			iCenter += bypp;
-			oPos += bypp;
+			oC[0] = dist(hC[0], vC[0]);
+			oC[1] = dist(hC[1], vC[1]);
+			oC[2] = dist(hC[2], vC[2]);
+			oC[3] = 255;
+			win.moveRight();
+			oC += ConstBGRAView::Channels;
 		}
 	}
+
+	processBorder(input, output, hFilter, vFilter, border, true);
 }
 
 ////////////////////////////////////////////////////////////////////////
 static bool operator==(const fipImage& im1, const fipImage& im2) {
-	assert(im1.getWidth() == im2.getWidth() && im1.getHeight() == im2.getHeight() && im1.getImageSize() == im2.getImageSize());
+	assert(im1.getWidth() == im2.getWidth() && im1.getHeight() == im2.getHeight() && im1.getBitsPerPixel() == im2.getBitsPerPixel());
 	assert(im1.getBitsPerPixel() == 32);
 
 	for(unsigned int i = 0; i < im1.getHeight(); i++) {
@@ -203,6 +311,18 @@ static bool operator!=(const fipImage& im1, const fipImage& im2) {
 	return !(im1 == im2);
 }
 
+////////////////////////////////////////////////////////////////////////
+// output file name of page p of a multi-page input: out.png -> out_1.png
+static string pageFileName(const char* fileName, int p) {
+	string name(fileName);
+	const size_t dot = name.find_last_of('.');
+	const size_t sep = name.find_last_of("/\\");
+	const string suffix = "_" + to_string(p);
+
+	if (dot == string::npos || (sep != string::npos && dot < sep)) return name + suffix;
+	return name.insert(dot, suffix);
+}
+
 ////////////////////////////////////////////////////////////////////////
 int imageProcessing(int argc, const char* argv[]) {
 	cout << "Image processing started" << endl;
@@ -212,29 +332,43 @@ int imageProcessing(int argc, const char* argv[]) {
 	}
 
 	Stopwatch sw;
-	fipImage image;
+	MappedImage mapping;
+	vector<fipImage> pages;
+	vector<double> decodeTimes;
 
-	// load image
-	if (!image.load(argv[1])) {
+	// load image: one read, pages of multi-page images are decoded in parallel, raw images (.rimg) are mapped
+	sw.Start();
+	if (!loadPages(argv[1], pages, mapping, 0, &decodeTimes)) {
 		cerr << "Image not found: " << argv[1] << endl;
 		return -1;
 	}
+	sw.Stop();
+	const double loadTime = sw.GetElapsedTimeMilliseconds();
+	const int nPages = (int)pages.size();
+	vector<double> computeTimes(nPages), saveTimes(nPages), waitTimes(nPages);
+	const fipImage& image = pages[0];
 
-	// create output images
-	fipImage out1(image), out2(image), out3(image);
+	// create output images: aligned pool buffers of the input's shape instead of copies of the input
+	ImagePool pool;
+	shared_ptr<fipImage> outputs[] = { pool.acquire(image), pool.acquire(image), pool.acquire(image) };
+	fipImage &out1 = *outputs[0], &out2 = *outputs[1], &out3 = *outputs[2];
+	ImageSaver saver;
 
 	// process image sequentially and produce out1
 	cout << "Start sequential process" << endl;
 	sw.Start();
-	processSerial(image, out1);
+	processSerial(image, out1, BorderMode::Clamp);
 	sw.Stop();
 	double seqTime = sw.GetElapsedTimeMilliseconds();
 	cout << seqTime << " ms" << endl;
 
+	// out1 is final: it is encoded and written in the background while the other versions are computed
+	saver.save(out1, argv[2]);
+
 	// process image sequentially but optimized and produce out2
 	cout << "Start optimized sequential process" << endl;
 	sw.Start();
-	processSerialOpt(image, out2);
+	processSerialOpt(image, out2, BorderMode::Clamp);
 	sw.Stop();
 	double seqOptTime = sw.GetElapsedTimeMilliseconds();
 	cout << seqOptTime << " ms, speedup = " << seqTime/seqOptTime << endl;
@@ -245,18 +379,46 @@ int imageProcessing(int argc, const char* argv[]) {
 	// process image in parallel and produce out3
 	cout << "Start parallel process" << endl;
 	sw.Start();
-	processParallel(image, out3);
+	processParallel(image, out3, BorderMode::Clamp);
 	sw.Stop();
 	cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << seqOptTime/sw.GetElapsedTimeMilliseconds() << endl;
+	computeTimes[0] = seqTime + seqOptTime + sw.GetElapsedTimeMilliseconds();
 
 	// compare out1 with out3
 	cout << boolalpha << "The two operations produce the same results: " << (out1 == out3) << endl;
 
-	// save output image
-	if (!out1.save(argv[2])) {
-		cerr << "Image not saved: " << argv[2] << endl;
+	// further pages of a multi-page image are processed in parallel: page p is computed while page p - 1 is saved
+	shared_ptr<fipImage> saving;
+	for(int p = 1; p < nPages; p++) {
+		shared_ptr<fipImage> out = pool.acquire(pages[p]);
+
+		sw.Start();
+		processParallel(pages[p], *out, BorderMode::Clamp);
+		sw.Stop();
+		computeTimes[p] = sw.GetElapsedTimeMilliseconds();
+		if (!saver.save(*out, pageFileName(argv[2], p))) {
+			saver.wait();
+			cerr << "Image not saved: " << ((p == 1) ? string(argv[2]) : pageFileName(argv[2], p - 1)) << endl;
+			return -1;
+		}
+		saveTimes[p - 1] = saver.getSaveTime();
+		waitTimes[p - 1] = saver.getWaitTime();
+		saving = out;
+	}
+
+	// wait for the last output image
+	if (!saver.wait()) {
+		cerr << "Image not saved: " << ((nPages == 1) ? string(argv[2]) : pageFileName(argv[2], nPages - 1)) << endl;
 		return -1;
 	}
+	saveTimes[nPages - 1] = saver.getSaveTime();
+	waitTimes[nPages - 1] = saver.getWaitTime();
+
+	// time breakdown per image: the pages are decoded in parallel, saving is hidden behind the computation except for the waiting time
+	cout << endl << "Load " << loadTime << " ms for " << nPages << " page(s)" << endl;
+	for(int p = 0; p < nPages; p++) {
+		cout << "Page " << p << ": load " << decodeTimes[p] << " ms, compute " << computeTimes[p] << " ms, save " << saveTimes[p] << " ms (" << waitTimes[p] << " ms not overlapped)" << endl;
+	}
 
 	return 0;
 }
\ No newline at end of file
@@ -26,7 +26,7 @@ void processACC(const fipImage& input, fipImage& output, const int *hFilter, con
 	const int bypp = 4;
 	const int w = input.getWidth();
 	const int h = input.getHeight();
-	assert(w == output.getWidth() && h == output.getHeight() && input.getImageSize() == output.getImageSize());
+	assert(w == output.getWidth() && h == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
 	assert(input.getBitsPerPixel() == bypp*8);
 	const size_t stride = input.getScanWidth();
 	const int fSizeD2 = fSize/2;
@@ -34,9 +34,10 @@ void processAMP(const fipImage& input, fipImage& output, const int *hFilter, con
 	const int bypp = 4;
 	const int w = input.getWidth();
 	const int h = input.getHeight();
-	assert(w == output.getWidth() && h == output.getHeight() && input.getImageSize() == output.getImageSize());
+	assert(w == output.getWidth() && h == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
 	assert(input.getBitsPerPixel() == bypp * 8);
 	const unsigned int stride = input.getScanWidth();
+	const unsigned int oStride = output.getScanWidth();
 	const int fSizeD2 = fSize / 2;
 
 	// list accelerators
@@ -53,7 +54,7 @@ void processAMP(const fipImage& input, fipImage& output, const int *hFilter, con
 
 	// create array-views: they manage data transport between host and GPU
 	Concurrency::array_view<const COLORREF, 2> avI(stride / bypp, h, reinterpret_cast<COLORREF*>(input.getScanLine(0)));
-	Concurrency::array_view<COLORREF, 2> avR(stride / bypp, h, reinterpret_cast<COLORREF*>(output.getScanLine(0)));
+	Concurrency::array_view<COLORREF, 2> avR(oStride / bypp, h, reinterpret_cast<COLORREF*>(output.getScanLine(0)));
 	avR.discard_data(); // don't copy data from host to GPU
 	Concurrency::array_view<const int, 2> avH(fSize, fSize, hFilter);
 	Concurrency::array_view<const int, 2> avV(fSize, fSize, vFilter);
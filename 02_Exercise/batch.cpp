@@ -0,0 +1,134 @@
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include <memory>
+#include <experimental/filesystem>
+#include "batch.h"
+#include "ImageIO.h"
+
+namespace fs = std::experimental::filesystem;
+
+void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag);
+
+////////////////////////////////////////////////////////////////////////
+// One image travelling through the batch pipeline
+struct BatchJob {
+	string m_fileName;
+	MappedImage m_mapping;	// pixels of raw input images
+	fipImage m_input;
+	fipImage m_output;
+	bool m_ok = false;
+};
+
+typedef unique_ptr<BatchJob> BatchJobPtr;
+
+////////////////////////////////////////////////////////////////////////
+void BatchStats::print(ostream& os) const {
+	os << m_images << " images in " << m_totalTime << " ms, " << imagesPerSecond() << " images/s";
+	if (m_failed) os << ", " << m_failed << " failed";
+	os << endl;
+	if (m_totalTime > 0) {
+		os << "stage utilization: decode " << 100*m_decodeTime/m_totalTime << " %, compute " << 100*m_computeTime/m_totalTime
+			<< " %, encode " << 100*m_encodeTime/m_totalTime << " %" << endl;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// a directory yields all its regular files, any other file is read as list with one image file name per line
+vector<string> listBatchFiles(const char* dirOrListFile) {
+	vector<string> files;
+
+	if (fs::is_directory(dirOrListFile)) {
+		for(const auto& entry: fs::directory_iterator(dirOrListFile)) {
+			if (fs::is_regular_file(entry.path())) files.push_back(entry.path().string());
+		}
+		sort(files.begin(), files.end());
+	} else {
+		ifstream list(dirOrListFile);
+		string line;
+
+		while(getline(list, line)) {
+			if (!line.empty() && line.back() == '\r') line.pop_back();
+			if (!line.empty()) files.push_back(line);
+		}
+	}
+	return files;
+}
+
+////////////////////////////////////////////////////////////////////////
+// gray and BGR images keep their format, all other formats are converted to 32 bits
+// decoder thread -> compute (calling thread with the OpenMP pool) -> encoder thread
+// the free queue holds depth + 2 jobs; when all are in flight the decoder blocks, which bounds memory
+BatchStats processBatch(const vector<string>& inputs, const char* outputDir, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag, int depth) {
+	const int jobs = max(depth, 1) + 2;
+	BoundedQueue<BatchJobPtr> freeJobs(jobs), decoded(max(depth, 1)), computed(max(depth, 1));
+	BatchStats stats;
+	Stopwatch total, decodeSw, computeSw, encodeSw;
+
+	for(int i = 0; i < jobs; i++) freeJobs.push(BatchJobPtr(new BatchJob()));
+	total.Start();
+
+	thread decoder([&] {
+		for(const string& fileName: inputs) {
+			BatchJobPtr job;
+
+			freeJobs.pop(job);
+			decodeSw.Restart();
+			job->m_fileName = fileName;
+			job->m_ok = loadImage(fileName.c_str(), job->m_input, job->m_mapping) && (isSupportedFormat(job->m_input) || job->m_input.convertTo32Bits());
+			decodeSw.Stop();
+			decoded.push(move(job));
+		}
+		decoded.close();
+	});
+
+	thread encoder([&] {
+		BatchJobPtr job;
+
+		while(computed.pop(job)) {
+			encodeSw.Restart();
+			if (job->m_ok) {
+				const string outName = (fs::path(outputDir)/fs::path(job->m_fileName).filename()).string();
+				job->m_ok = saveImage(job->m_output, outName.c_str());
+			}
+			encodeSw.Stop();
+			if (job->m_ok) {
+				stats.m_images++;
+			} else {
+				cerr << "Image not processed: " << job->m_fileName << endl;
+				stats.m_failed++;
+			}
+			freeJobs.push(move(job));
+		}
+	});
+
+	BatchJobPtr job;
+	while(decoded.pop(job)) {
+		computeSw.Restart();
+		if (job->m_ok) {
+			fipImage& in = job->m_input;
+			fipImage& out = job->m_output;
+
+			// reuse the output buffer of the previous image if possible; skip mode keeps the input pixels at the border
+			if (border == BorderMode::Skip) {
+				out = in;
+			} else if (out.getWidth() != in.getWidth() || out.getHeight() != in.getHeight() || out.getImageType() != in.getImageType() || out.getBitsPerPixel() != in.getBitsPerPixel()) {
+				out.setSize(in.getImageType(), in.getWidth(), in.getHeight(), in.getBitsPerPixel());
+			}
+			processParallel(in, out, hFilter, vFilter, fSize, border, mag);
+		}
+		computeSw.Stop();
+		computed.push(move(job));
+	}
+	computed.close();
+
+	decoder.join();
+	encoder.join();
+	total.Stop();
+
+	stats.m_totalTime = total.GetElapsedTimeMilliseconds();
+	stats.m_decodeTime = decodeSw.GetElapsedTimeMilliseconds();
+	stats.m_computeTime = computeSw.GetElapsedTimeMilliseconds();
+	stats.m_encodeTime = encodeSw.GetElapsedTimeMilliseconds();
+	return stats;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include "main.h"
+#include "magnitude.h"
+
+////////////////////////////////////////////////////////////////////////
+// Bounded FIFO between two pipeline stages: push blocks while the queue is full (backpressure),
+// pop blocks while it is empty and returns false once the queue is closed and drained
+template<typename T> class BoundedQueue {
+	deque<T> m_items;
+	size_t m_capacity;
+	bool m_closed = false;
+	mutex m_mutex;
+	condition_variable m_notFull, m_notEmpty;
+
+public:
+	BoundedQueue(size_t capacity) : m_capacity(capacity) {}
+
+	void push(T item) {
+		unique_lock<mutex> lock(m_mutex);
+		m_notFull.wait(lock, [this] { return m_items.size() < m_capacity; });
+		m_items.push_back(move(item));
+		m_notEmpty.notify_one();
+	}
+	bool pop(T& item) {
+		unique_lock<mutex> lock(m_mutex);
+		m_notEmpty.wait(lock, [this] { return !m_items.empty() || m_closed; });
+		if (m_items.empty()) return false;
+		item = move(m_items.front());
+		m_items.pop_front();
+		m_notFull.notify_one();
+		return true;
+	}
+	void close() {
+		lock_guard<mutex> lock(m_mutex);
+		m_closed = true;
+		m_notEmpty.notify_all();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+// Busy times of the three batch stages
+struct BatchStats {
+	int m_images = 0;
+	int m_failed = 0;
+	double m_totalTime = 0;		// wall-clock time in ms
+	double m_decodeTime = 0;
+	double m_computeTime = 0;
+	double m_encodeTime = 0;
+
+	double imagesPerSecond() const { return (m_totalTime > 0) ? 1000.0*m_images/m_totalTime : 0; }
+	void print(ostream& os) const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// Batch edge detection: decode, convolution and encode run as a 3-stage pipeline connected by bounded queues of the given depth.
+// Image buffers circulate between the stages and are reused as long as the image size does not change.
+vector<string> listBatchFiles(const char* dirOrListFile);
+BatchStats processBatch(const vector<string>& inputs, const char* outputDir, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag, int depth);
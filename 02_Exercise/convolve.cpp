@@ -0,0 +1,347 @@
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+#include "convolve.h"
+#include "planar.h"
+#include "integral.h"
+
+void processOCL(OCLData& ocl, const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize);
+
+////////////////////////////////////////////////////////////////////////
+const char* strategyName(Strategy s) {
+	switch(s) {
+	case Strategy::Separable: return "separable";
+	case Strategy::Box: return "box";
+	case Strategy::SIMD: return "SIMD";
+	case Strategy::OpenCL: return "OpenCL";
+	default: return "direct";
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+bool isApplicable(Strategy s, const fipImage& input, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag, const OCLData* ocl) {
+	const bool samePair = hKernel.getSize() == vKernel.getSize() && hKernel.getDivisor() == 1 && vKernel.getDivisor() == 1;
+
+	switch(s) {
+	case Strategy::Separable:
+		return hKernel.isSeparable() && vKernel.isSeparable();
+	case Strategy::Box:
+		// four lookups per box instead of one multiply-add per weight
+		return 4*(hKernel.getBoxes().size() + vKernel.getBoxes().size()) < (size_t)(hKernel.getTaps() + vKernel.getTaps());
+	case Strategy::SIMD:
+		return samePair;
+	case Strategy::OpenCL:
+		// transfers dominate on small images
+		return samePair && ocl && ocl->m_kernel() && border == BorderMode::Clamp && mag != MagnitudeMode::L1
+			&& (size_t)input.getWidth()*input.getHeight() >= 256*256;
+	default:
+		return true;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// copy of a 32-bit image with an apron of a pixels filled according to the border mode
+static void pad(const fipImage& image, int a, BorderMode border, vector<BYTE>& padded) {
+	const int w = image.getWidth();
+	const int h = image.getHeight();
+	const int pw = w + 2*a;
+
+	if (border == BorderMode::Skip) border = BorderMode::Clamp;
+	padded.resize(4*(size_t)pw*(h + 2*a));
+
+	#pragma omp parallel for
+	for(int y = -a; y < h + a; y++) {
+		const int sy = borderIndex(y, h, border);
+		BYTE *row = padded.data() + 4*(size_t)pw*(y + a);
+
+		if (sy < 0) {
+			memset(row, 0, 4*pw);
+			continue;
+		}
+		const BYTE *src = image.getScanLine(sy);
+		memcpy(row + 4*a, src, 4*w);
+		for(int x = -a; x < 0; x++) {
+			const int sx = borderIndex(x, w, border);
+			if (sx < 0) memset(row + 4*(x + a), 0, 4); else memcpy(row + 4*(x + a), src + 4*sx, 4);
+		}
+		for(int x = w; x < w + a; x++) {
+			const int sx = borderIndex(x, w, border);
+			if (sx < 0) memset(row + 4*(x + a), 0, 4); else memcpy(row + 4*(x + a), src + 4*sx, 4);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// response rows of all output rows, converted by the magnitude stage; skip mode leaves a border of a pixels untouched.
+// responses(v, u0, u1, hRow, vRow) fills 4 ints per pixel for the pixels [u0,u1) of row v.
+template<typename F>
+static void processRows(fipImage& output, const Kernel& hKernel, const Kernel& vKernel, int a, BorderMode border, MagnitudeMode mag, const F& responses) {
+	const int w = output.getWidth();
+	const int h = output.getHeight();
+	const int margin = (border == BorderMode::Skip) ? a : 0;
+	const int u1 = max(w - margin, margin);
+	const int hDivisor = hKernel.getDivisor();
+	const int vDivisor = vKernel.getDivisor();
+
+	#pragma omp parallel
+	{
+		vector<int> hRow(4*w), vRow(4*w);
+
+		#pragma omp for
+		for(int v = margin; v < h - margin; v++) {
+			responses(v, margin, u1, hRow.data(), vRow.data());
+			if (hDivisor != 1 || vDivisor != 1) {
+				for(int i = 4*margin; i < 4*u1; i++) {
+					hRow[i] /= hDivisor;
+					vRow[i] /= vDivisor;
+				}
+			}
+			magnitude(hRow.data() + 4*margin, vRow.data() + 4*margin, output.getScanLine(v) + 4*margin, u1 - margin, mag);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// non-zero weights as byte offsets into the padded image relative to the center pixel
+struct Tap {
+	ptrdiff_t m_offset;
+	int m_weight;
+};
+
+static vector<Tap> taps(const Kernel& kernel, int pw) {
+	const int r = kernel.getSize()/2;
+	vector<Tap> result;
+
+	for(int y = 0; y < kernel.getSize(); y++) {
+		for(int x = 0; x < kernel.getSize(); x++) {
+			if (kernel(x, y) != 0) result.push_back({ 4*((ptrdiff_t)(y - r)*pw + x - r), kernel(x, y) });
+		}
+	}
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////
+static void processDirect(const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, int a, BorderMode border, MagnitudeMode mag) {
+	const int pw = input.getWidth() + 2*a;
+	const vector<Tap> hTaps = taps(hKernel, pw);
+	const vector<Tap> vTaps = taps(vKernel, pw);
+	vector<BYTE> padded;
+
+	pad(input, a, border, padded);
+	processRows(output, hKernel, vKernel, a, border, mag, [&](int v, int u0, int u1, int *hRow, int *vRow) {
+		const BYTE *center = padded.data() + 4*((size_t)(v + a)*pw + a);
+
+		for(int u = u0; u < u1; u++) {
+			int hC[3] = {}, vC[3] = {};
+			const BYTE *iC = center + 4*u;
+
+			for(const Tap& t: hTaps) {
+				for(int c = 0; c < 3; c++) hC[c] += t.m_weight*iC[t.m_offset + c];
+			}
+			for(const Tap& t: vTaps) {
+				for(int c = 0; c < 3; c++) vC[c] += t.m_weight*iC[t.m_offset + c];
+			}
+			for(int c = 0; c < 3; c++) {
+				hRow[4*u + c] = hC[c];
+				vRow[4*u + c] = vC[c];
+			}
+			hRow[4*u + 3] = vRow[4*u + 3] = 0;
+		}
+	});
+}
+
+////////////////////////////////////////////////////////////////////////
+// row pass of a rank-1 kernel over all rows of the padded image: 4 ints per pixel of the w output columns
+static void rowPass(const vector<BYTE>& padded, int w, int rows, int a, const Kernel& kernel, vector<int>& tmp) {
+	const int pw = w + 2*a;
+	const int r = kernel.getSize()/2;
+	const vector<int>& weights = kernel.getRow();
+
+	tmp.resize(4*(size_t)w*rows);
+
+	#pragma omp parallel for
+	for(int y = 0; y < rows; y++) {
+		const BYTE *row = padded.data() + 4*((size_t)y*pw + a - r);
+		int *tC = tmp.data() + 4*(size_t)y*w;
+
+		for(int u = 0; u < w; u++) {
+			int sum[4] = {};
+
+			for(int i = 0; i < kernel.getSize(); i++) {
+				for(int c = 0; c < 3; c++) sum[c] += weights[i]*row[4*(u + i) + c];
+			}
+			copy(sum, sum + 4, tC + 4*u);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+static void processSeparable(const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, int a, BorderMode border, MagnitudeMode mag) {
+	const int w = input.getWidth();
+	const int rows = input.getHeight() + 2*a;
+	vector<BYTE> padded;
+	vector<int> hTmp, vTmp;
+
+	pad(input, a, border, padded);
+	rowPass(padded, w, rows, a, hKernel, hTmp);
+	rowPass(padded, w, rows, a, vKernel, vTmp);
+
+	// column pass of one kernel for the pixels [u0,u1) of row v
+	auto columnPass = [&](const vector<int>& tmp, const Kernel& kernel, int v, int u0, int u1, int *out) {
+		const int r = kernel.getSize()/2;
+		const vector<int>& weights = kernel.getColumn();
+
+		fill(out + 4*u0, out + 4*u1, 0);
+		for(int j = 0; j < kernel.getSize(); j++) {
+			const int f = weights[j];
+			const int *tC = tmp.data() + 4*((size_t)(v + a + j - r)*w);
+
+			if (f == 0) continue;
+			for(int i = 4*u0; i < 4*u1; i++) out[i] += f*tC[i];
+		}
+	};
+
+	processRows(output, hKernel, vKernel, a, border, mag, [&](int v, int u0, int u1, int *hRow, int *vRow) {
+		columnPass(hTmp, hKernel, v, u0, u1, hRow);
+		columnPass(vTmp, vKernel, v, u0, u1, vRow);
+	});
+}
+
+////////////////////////////////////////////////////////////////////////
+static void processBoxes(const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, int a, BorderMode border, MagnitudeMode mag) {
+	IntegralImage<uint32_t> sat;
+
+	// sum of the weighted boxes of one kernel for pixel (u, v)
+	auto boxes = [&](const Kernel& kernel, int u, int v, int *out) {
+		const int r = kernel.getSize()/2;
+
+		out[0] = out[1] = out[2] = out[3] = 0;
+		for(const Kernel::Box& b: kernel.getBoxes()) {
+			for(int c = 0; c < 3; c++) {
+				out[c] += b.m_weight*(int)sat.boxSum(c, u - r + b.m_x0, v - r + b.m_y0, u - r + b.m_x1, v - r + b.m_y1);
+			}
+		}
+	};
+
+	sat.build(input, a, border);
+	processRows(output, hKernel, vKernel, a, border, mag, [&](int v, int u0, int u1, int *hRow, int *vRow) {
+		for(int u = u0; u < u1; u++) {
+			boxes(hKernel, u, v, hRow + 4*u);
+			boxes(vKernel, u, v, vRow + 4*u);
+		}
+	});
+}
+
+////////////////////////////////////////////////////////////////////////
+void convolve(Strategy s, const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag, OCLData* ocl) {
+	assert(input.getImageType() == FIT_BITMAP && input.getBitsPerPixel() == 32);
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
+	assert(isApplicable(s, input, hKernel, vKernel, border, mag, ocl));
+	const int a = max(hKernel.getSize(), vKernel.getSize())/2;
+
+	switch(s) {
+	case Strategy::Separable:
+		processSeparable(input, output, hKernel, vKernel, a, border, mag);
+		break;
+	case Strategy::Box:
+		processBoxes(input, output, hKernel, vKernel, a, border, mag);
+		break;
+	case Strategy::SIMD: {
+		PlanarImage planarIn(a), planarOut;
+
+		planarIn.deinterleave(input, border);
+		processPlanar(planarIn, planarOut, hKernel.data(), vKernel.data(), hKernel.getSize(), border, mag);
+		planarOut.interleave(output);
+		break;
+	}
+	case Strategy::OpenCL:
+		processOCL(*ocl, input, output, hKernel.data(), vKernel.data(), hKernel.getSize());
+		break;
+	default:
+		processDirect(input, output, hKernel, vKernel, a, border, mag);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+KernelTuner::KernelTuner(OCLData *ocl)
+	: m_ocl(ocl), m_device("CPU " + to_string(omp_get_max_threads()) + " threads")
+{
+	if (m_ocl && m_ocl->m_kernel()) {
+		try {
+			m_device += ", " + m_ocl->m_queue.getInfo<CL_QUEUE_DEVICE>().getInfo<CL_DEVICE_NAME>();
+		} catch(cl::Error& err) {
+			cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+string KernelTuner::key(const fipImage& input, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag) const {
+	return hKernel.getShape() + "; " + vKernel.getShape() + "; " + to_string(input.getWidth()) + "x" + to_string(input.getHeight())
+		+ "; " + borderModeName(border) + "; " + magnitudeModeName(mag) + "; " + m_device;
+}
+
+////////////////////////////////////////////////////////////////////////
+Strategy KernelTuner::select(const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag) {
+	const Strategy strategies[] = { Strategy::Direct, Strategy::Separable, Strategy::Box, Strategy::SIMD, Strategy::OpenCL };
+	const string k = key(input, hKernel, vKernel, border, mag);
+	auto it = m_decisions.find(k);
+
+	// decisions loaded from a file may refer to a device that is not available
+	if (it != m_decisions.end() && isApplicable(it->second, input, hKernel, vKernel, border, mag, m_ocl)) return it->second;
+
+	// first use: time every applicable strategy once
+	Stopwatch sw;
+	Strategy best = Strategy::Direct;
+	double bestTime = 0;
+
+	m_times.clear();
+	for(Strategy s: strategies) {
+		if (!isApplicable(s, input, hKernel, vKernel, border, mag, m_ocl)) continue;
+
+		sw.Start();
+		convolve(s, input, output, hKernel, vKernel, border, mag, m_ocl);
+		sw.Stop();
+		m_times[s] = sw.GetElapsedTimeMilliseconds();
+		if (m_times.size() == 1 || m_times[s] < bestTime) {
+			best = s;
+			bestTime = m_times[s];
+		}
+	}
+	m_decisions[k] = best;
+	return best;
+}
+
+////////////////////////////////////////////////////////////////////////
+void KernelTuner::process(const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag) {
+	convolve(select(input, output, hKernel, vKernel, border, mag), input, output, hKernel, vKernel, border, mag, m_ocl);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool KernelTuner::load(const char* fileName) {
+	const Strategy strategies[] = { Strategy::Direct, Strategy::Separable, Strategy::Box, Strategy::SIMD, Strategy::OpenCL };
+	ifstream file(fileName);
+	string line;
+
+	if (!file) return false;
+	while(getline(file, line)) {
+		const size_t tab = line.rfind('\t');
+		if (tab == string::npos) continue;
+
+		const string name = line.substr(tab + 1);
+		for(Strategy s: strategies) {
+			if (name == strategyName(s)) m_decisions[line.substr(0, tab)] = s;
+		}
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool KernelTuner::save(const char* fileName) const {
+	ofstream file(fileName, ios::trunc);
+
+	for(const auto& d: m_decisions) file << d.first << '\t' << strategyName(d.second) << endl;
+	return file.good();
+}
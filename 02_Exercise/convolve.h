@@ -0,0 +1,51 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include "main.h"
+#include "magnitude.h"
+#include "ocl.h"
+#include "Kernel.h"
+
+////////////////////////////////////////////////////////////////////////
+// Edge detection of 32-bit images with any pair of odd-sized kernels: each response is divided by the divisor
+// of its kernel and both are combined by the magnitude stage; a single kernel is paired with a zero kernel,
+// which yields |response|. The border mode applies to a border of max(size)/2 pixels.
+// Direct: non-zero weights only, on a copy of the input with an apron (any kernels)
+// Separable: row pass followed by a column pass (rank-1 kernels)
+// Box: weighted box sums on a summed-area table (kernels made of few rectangles of equal weight)
+// SIMD: planar SSE convolution (kernels of the same size with divisor 1)
+// OpenCL: GPU (kernels of the same size with divisor 1, clamp border, exact magnitude)
+enum class Strategy { Direct, Separable, Box, SIMD, OpenCL };
+const char* strategyName(Strategy s);
+
+// structural check and image size heuristic: strategies that cannot be faster are not applicable either
+bool isApplicable(Strategy s, const fipImage& input, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag, const OCLData* ocl);
+void convolve(Strategy s, const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag, OCLData* ocl);
+
+////////////////////////////////////////////////////////////////////////
+// Chooses the implementation per kernel shapes, image size, border mode and device: on first use all applicable
+// strategies are timed on the actual image, the fastest is remembered and can be stored in a file.
+class KernelTuner {
+	OCLData *m_ocl;
+	string m_device;
+	map<string, Strategy> m_decisions;
+	map<Strategy, double> m_times;		// times of the last tuning in ms
+
+	string key(const fipImage& input, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag) const;
+
+public:
+	// ocl may be null or uninitialized, then the CPU strategies are considered only
+	KernelTuner(OCLData *ocl = nullptr);
+
+	Strategy select(const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag);
+	void process(const fipImage& input, fipImage& output, const Kernel& hKernel, const Kernel& vKernel, BorderMode border, MagnitudeMode mag);
+
+	// decisions of previous runs: one line per decision with key and strategy separated by a tab
+	bool load(const char* fileName);
+	bool save(const char* fileName) const;
+
+	const string& getDevice() const { return m_device; }
+	size_t getDecisions() const { return m_decisions.size(); }
+	const map<Strategy, double>& getTimes() const { return m_times; }
+};
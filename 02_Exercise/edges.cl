@@ -1,14 +1,25 @@
 ////////////////////////////////////////////////////////////////////////
-uint dist(int x, int y) {
-	uint d = (uint)sqrt((float)(x*x) + (float)(y*y));
-	return (d < 256) ? d : 255;
+// maxValue is 255 for 8-bit and 65535 for 16-bit channels
+// floor of the exact square root like the CPU versions: the float estimate is not precise enough for 16-bit channels
+// and is corrected with 64-bit integers; double precision is optional in OpenCL 1.2
+uint dist(int x, int y, uint maxValue) {
+	const ulong s = (ulong)((long)x*x + (long)y*y);
+	ulong d;
+
+	if (s >= (ulong)maxValue*maxValue) return maxValue;
+	d = (ulong)sqrt((float)s);
+	while(d*d > s) d--;
+	while((d + 1)*(d + 1) <= s) d++;
+	return (uint)d;
 }
 
 ////////////////////////////////////////////////////////////////////////
 // OpenCL kernel
-__kernel void edges(__read_only image2d_t source, __write_only image2d_t dest, __constant int* hFilter, __constant int* vFilter, int fSize, sampler_t sampler) {
-	const int w = get_global_size(0);
-	const int h = get_global_size(1);
+// single-channel images (CL_R) deliver their value in x, the other lanes are zero and ignored when written
+__kernel void edges(__read_only image2d_t source, __write_only image2d_t dest, __constant int* hFilter, __constant int* vFilter, int fSize, sampler_t sampler, uint maxValue) {
+	// the global range may be padded to multiples of the work-group size
+	const int w = get_image_width(dest);
+	const int h = get_image_height(dest);
 	const int col = get_global_id(0);
 	const int row = get_global_id(1);
 	const int fSizeD2 = fSize/2;
@@ -42,7 +53,7 @@ __kernel void edges(__read_only image2d_t source, __write_only image2d_t dest, _
 		// pixel lies inside output image
 		coords.x = col;
 		coords.y = row;
-		uint4 p = { dist(hC.x, vC.x), dist(hC.y, vC.y), dist(hC.z, vC.z), 255 };
+		uint4 p = { dist(hC.x, vC.x, maxValue), dist(hC.y, vC.y, maxValue), dist(hC.z, vC.z, maxValue), 255 };
 
 		write_imageui(dest, coords, p);
 	}
@@ -112,7 +123,7 @@ __kernel void edgesWithLocalMem(__read_only image2d_t source, __write_only image
 		// pixel lies inside output image
 		coords.x = col;
 		coords.y = row;
-		uint4 p = { dist(hC.x, vC.x), dist(hC.y, vC.y), dist(hC.z, vC.z), 255 };
+		uint4 p = { dist(hC.x, vC.x, 255), dist(hC.y, vC.y, 255), dist(hC.z, vC.z, 255), 255 };
 
 		write_imageui(dest, coords, p);
 	}
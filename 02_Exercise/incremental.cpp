@@ -0,0 +1,150 @@
+#include <cstring>
+#include <algorithm>
+#include "incremental.h"
+
+void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag);
+void processRegions(const fipImage& input, fipImage& output, const vector<Region>& regions, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag);
+
+////////////////////////////////////////////////////////////////////////
+// parts of [a,b) inside [0,n); in wrap mode the parts outside are mapped into [0,n) as well
+static int axisIntervals(int a, int b, int n, bool wrap, int (&lo)[3], int (&hi)[3]) {
+	int k = 0;
+	auto add = [&](int l, int h) {
+		l = max(l, 0);
+		h = min(h, n);
+		if (l < h) {
+			lo[k] = l;
+			hi[k] = h;
+			k++;
+		}
+	};
+
+	add(a, b);
+	if (wrap) {
+		add(a + n, b + n);
+		add(a - n, b - n);
+	}
+	return k;
+}
+
+////////////////////////////////////////////////////////////////////////
+FrameStream::FrameStream(const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag, int tileSize)
+	: m_hFilter(hFilter), m_vFilter(vFilter), m_fSize(fSize), m_border(border), m_mag(mag), m_tileSize(max(tileSize, 1))
+{}
+
+////////////////////////////////////////////////////////////////////////
+void FrameStream::reset() {
+	m_previous.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+// marks the tiles that differ from the previous frame and copies their new pixels into the previous frame
+void FrameStream::diffTiles(const fipImage& frame) {
+	const int w = frame.getWidth();
+	const int h = frame.getHeight();
+	const int bypp = frame.getBitsPerPixel()/8;
+
+	#pragma omp parallel for schedule(dynamic)
+	for(int t = 0; t < m_tilesX*m_tilesY; t++) {
+		const int x0 = (t%m_tilesX)*m_tileSize;
+		const int y0 = (t/m_tilesX)*m_tileSize;
+		const int y1 = min(y0 + m_tileSize, h);
+		const size_t offset = (size_t)bypp*x0;
+		const size_t n = (size_t)bypp*(min(x0 + m_tileSize, w) - x0);
+		bool changed = false;
+
+		for(int y = y0; y < y1; y++) {
+			const BYTE *src = frame.getScanLine(y) + offset;
+			BYTE *prev = m_previous.getScanLine(y) + offset;
+
+			if (changed || memcmp(src, prev, n) != 0) {
+				changed = true;
+				memcpy(prev, src, n);
+			}
+		}
+		m_changed[t] = changed;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// adds region r to the dirty parts of all tiles it overlaps
+void FrameStream::addDirty(const Region& r) {
+	for(int ty = r.m_y0/m_tileSize; ty <= (r.m_y1 - 1)/m_tileSize; ty++) {
+		for(int tx = r.m_x0/m_tileSize; tx <= (r.m_x1 - 1)/m_tileSize; tx++) {
+			Region& d = m_dirty[ty*m_tilesX + tx];
+			const Region part = {
+				max(r.m_x0, tx*m_tileSize), max(r.m_y0, ty*m_tileSize),
+				min(r.m_x1, (tx + 1)*m_tileSize), min(r.m_y1, (ty + 1)*m_tileSize)
+			};
+
+			if (d.isEmpty()) {
+				d = part;
+			} else {
+				d = { min(d.m_x0, part.m_x0), min(d.m_y0, part.m_y0), max(d.m_x1, part.m_x1), max(d.m_y1, part.m_y1) };
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+const fipImage& FrameStream::process(const fipImage& frame) {
+	assert(isSupportedFormat(frame));
+	const int w = frame.getWidth();
+	const int h = frame.getHeight();
+	const int fSizeD2 = m_fSize/2;
+
+	m_frames++;
+
+	// first frame or new shape: everything is computed, skip mode keeps the input pixels at the border
+	if (!m_previous.isValid() || (int)m_previous.getWidth() != w || (int)m_previous.getHeight() != h
+		|| m_previous.getImageType() != frame.getImageType() || m_previous.getBitsPerPixel() != frame.getBitsPerPixel()) {
+		m_previous = frame;
+		m_output = frame;
+		processParallel(frame, m_output, m_hFilter, m_vFilter, m_fSize, m_border, m_mag);
+		m_tilesX = (w + m_tileSize - 1)/m_tileSize;
+		m_tilesY = (h + m_tileSize - 1)/m_tileSize;
+		m_changed.assign(m_tilesX*m_tilesY, 0);
+		m_dirty.resize(m_tilesX*m_tilesY);
+		return m_output;
+	}
+
+	diffTiles(frame);
+
+	// dirty parts: changed tiles dilated by the filter radius; in wrap mode the filter windows reach across the edges
+	const bool wrap = m_border == BorderMode::Wrap;
+	fill(m_dirty.begin(), m_dirty.end(), Region{ 0, 0, 0, 0 });
+	for(int t = 0; t < m_tilesX*m_tilesY; t++) {
+		if (!m_changed[t]) continue;
+
+		const int x0 = (t%m_tilesX)*m_tileSize;
+		const int y0 = (t/m_tilesX)*m_tileSize;
+		int xLo[3], xHi[3], yLo[3], yHi[3];
+		const int nx = axisIntervals(x0 - fSizeD2, min(x0 + m_tileSize, w) + fSizeD2, w, wrap, xLo, xHi);
+		const int ny = axisIntervals(y0 - fSizeD2, min(y0 + m_tileSize, h) + fSizeD2, h, wrap, yLo, yHi);
+
+		for(int j = 0; j < ny; j++) {
+			for(int i = 0; i < nx; i++) addDirty({ xLo[i], yLo[j], xHi[i], yHi[j] });
+		}
+	}
+
+	vector<Region> regions;
+	m_pixels += (double)w*h;
+	for(const Region& d: m_dirty) {
+		if (d.isEmpty()) continue;
+		regions.push_back(d);
+		m_recomputed += d.getArea();
+	}
+
+	// skip mode leaves the border untouched, hence it has to show the new input pixels
+	if (m_border == BorderMode::Skip) {
+		const int bypp = frame.getBitsPerPixel()/8;
+
+		for(const Region& r: regions) {
+			for(int y = r.m_y0; y < r.m_y1; y++) {
+				memcpy(m_output.getScanLine(y) + bypp*r.m_x0, frame.getScanLine(y) + bypp*r.m_x0, bypp*(r.m_x1 - r.m_x0));
+			}
+		}
+	}
+	processRegions(frame, m_output, regions, m_hFilter, m_vFilter, m_fSize, m_border, m_mag);
+	return m_output;
+}
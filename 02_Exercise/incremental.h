@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+#include "main.h"
+#include "magnitude.h"
+
+////////////////////////////////////////////////////////////////////////
+// Edge detection on a stream of frames of the same shape, e.g. camera frames where only small parts change.
+// Every frame is compared with the previous one tile by tile. Only the changed tiles dilated by fSize/2 pixels
+// are recomputed, the output of the previous frame is reused everywhere else.
+class FrameStream {
+	const int *m_hFilter;
+	const int *m_vFilter;
+	int m_fSize;
+	BorderMode m_border;
+	MagnitudeMode m_mag;
+	int m_tileSize;
+	int m_tilesX = 0;
+	int m_tilesY = 0;
+	fipImage m_previous;			// last input frame
+	fipImage m_output;				// edge image of the last frame
+	vector<char> m_changed;			// per tile: pixels differ from the previous frame
+	vector<Region> m_dirty;			// per tile: part that has to be recomputed (bounding box)
+	size_t m_frames = 0;
+	double m_pixels = 0;			// pixels of the incrementally computed frames
+	double m_recomputed = 0;		// recomputed pixels of the incrementally computed frames
+
+	void diffTiles(const fipImage& frame);
+	void addDirty(const Region& r);
+
+public:
+	FrameStream(const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag, int tileSize = 32);
+
+	// edge image of the next frame; it is valid until the next call
+	const fipImage& process(const fipImage& frame);
+	// the next frame is computed completely
+	void reset();
+
+	size_t getFrames() const { return m_frames; }
+	// share of the recomputed pixels in all frames but the completely computed ones
+	double getRecomputedFraction() const { return (m_pixels > 0) ? m_recomputed/m_pixels : 0; }
+};
@@ -0,0 +1,123 @@
+#include <vector>
+#include <algorithm>
+#include "integral.h"
+
+////////////////////////////////////////////////////////////////////////
+template<typename S>
+void IntegralImage<S>::build(const fipImage& image, int apron, BorderMode border) {
+	assert(image.getImageType() == FIT_BITMAP && image.getBitsPerPixel() == 32);
+	const int w = image.getWidth();
+	const int h = image.getHeight();
+	const int aw = w + 2*apron;
+	const int ah = h + 2*apron;
+	const int n = 4*(aw + 1);		// sums per table row
+	const int Strip = 64;			// sums per column strip: 256 bytes with 32-bit accumulators
+
+	if (border == BorderMode::Skip) border = BorderMode::Clamp;
+	m_width = w;
+	m_height = h;
+	m_apron = apron;
+	m_stride = aw + 1;
+	m_sums.resize((size_t)n*(ah + 1));
+	fill(m_sums.begin(), m_sums.begin() + n, 0);
+
+	// row pass: prefix sums along every row, the first entry of a row stays zero
+	#pragma omp parallel for
+	for(int y = 0; y < ah; y++) {
+		const int iy = borderIndex(y - apron, h, border);
+		const BYTE *src = (iy >= 0) ? image.getScanLine(iy) : nullptr;
+		S *row = m_sums.data() + (size_t)n*(y + 1);
+		S sum[4] = {};
+
+		for(int c = 0; c < 4; c++) row[c] = 0;
+		for(int x = 0; x < aw; x++) {
+			const int ix = borderIndex(x - apron, w, border);
+
+			if (src && ix >= 0) {
+				const BYTE *iC = src + 4*ix;
+				for(int c = 0; c < 4; c++) sum[c] += iC[c];
+			}
+			row += 4;
+			for(int c = 0; c < 4; c++) row[c] = sum[c];
+		}
+	}
+
+	// column pass: prefix sums down every column; each thread walks a strip of columns from top to bottom
+	#pragma omp parallel for
+	for(int s = 0; s < n; s += Strip) {
+		const int e = min(s + Strip, n);
+
+		for(int y = 2; y <= ah; y++) {
+			S *row = m_sums.data() + (size_t)n*y;
+			const S *prev = row - n;
+
+			for(int i = s; i < e; i++) row[i] += prev[i];
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+template<typename S>
+void boxFilter(const IntegralImage<S>& sat, fipImage& output, int radius) {
+	const int w = sat.getWidth();
+	const int h = sat.getHeight();
+	const S area = (S)(2*radius + 1)*(2*radius + 1);
+
+	assert(output.getImageType() == FIT_BITMAP && output.getBitsPerPixel() == 32);
+	assert((int)output.getWidth() == w && (int)output.getHeight() == h);
+	assert(radius >= 0 && radius <= sat.getApron());
+
+	#pragma omp parallel for
+	for(int v = 0; v < h; v++) {
+		BYTE *oC = output.getScanLine(v);
+
+		for(int u = 0; u < w; u++) {
+			for(int c = 0; c < 4; c++) {
+				oC[c] = (BYTE)((sat.boxSum(c, u - radius, v - radius, u + radius + 1, v + radius + 1) + area/2)/area);
+			}
+			oC += 4;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// hFilter: row v - 1 minus row v + 1 over the columns u - fSize/2 .. u + fSize/2,
+// vFilter: column u - 1 minus column u + 1 over the rows v - fSize/2 .. v + fSize/2
+template<typename S>
+void processIntegral(const IntegralImage<S>& sat, fipImage& output, int fSize, BorderMode border, MagnitudeMode mag) {
+	const int w = sat.getWidth();
+	const int h = sat.getHeight();
+	const int fSizeD2 = fSize/2;
+	const int v0 = (border == BorderMode::Skip) ? fSizeD2 : 0;
+	const int u0 = v0;
+	const int u1 = max(w - v0, u0);
+
+	assert(output.getImageType() == FIT_BITMAP && output.getBitsPerPixel() == 32);
+	assert((int)output.getWidth() == w && (int)output.getHeight() == h);
+	assert(fSizeD2 <= sat.getApron());
+
+	#pragma omp parallel
+	{
+		vector<int> hRow(4*w), vRow(4*w);		// alpha lanes stay zero
+
+		#pragma omp for
+		for(int v = v0; v < h - v0; v++) {
+			for(int u = u0; u < u1; u++) {
+				for(int c = 0; c < 3; c++) {
+					hRow[4*u + c] = (int)sat.boxSum(c, u - fSizeD2, v - 1, u + fSizeD2 + 1, v) - (int)sat.boxSum(c, u - fSizeD2, v + 1, u + fSizeD2 + 1, v + 2);
+					vRow[4*u + c] = (int)sat.boxSum(c, u - 1, v - fSizeD2, u, v + fSizeD2 + 1) - (int)sat.boxSum(c, u + 1, v - fSizeD2, u + 2, v + fSizeD2 + 1);
+				}
+			}
+			magnitude(hRow.data() + 4*u0, vRow.data() + 4*u0, output.getScanLine(v) + 4*u0, u1 - u0, mag);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// 32- and 64-bit accumulators
+template class IntegralImage<uint32_t>;
+template class IntegralImage<uint64_t>;
+template void boxFilter(const IntegralImage<uint32_t>& sat, fipImage& output, int radius);
+template void boxFilter(const IntegralImage<uint64_t>& sat, fipImage& output, int radius);
+template void processIntegral(const IntegralImage<uint32_t>& sat, fipImage& output, int fSize, BorderMode border, MagnitudeMode mag);
+template void processIntegral(const IntegralImage<uint64_t>& sat, fipImage& output, int fSize, BorderMode border, MagnitudeMode mag);
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "main.h"
+#include "magnitude.h"
+
+////////////////////////////////////////////////////////////////////////
+// Summed-area table (integral image) of the blue, green, red and alpha channel of a 32-bit image.
+// Entry (x, y) holds the sums of all pixels in [0,x) x [0,y), hence the sum over any box costs four lookups.
+// The table covers an apron of getApron() pixels around the image filled according to the border mode,
+// so boxes reaching up to the apron width across the edge are exact in every border mode.
+// Rows are numbered like fipImage scanlines; the four channel sums of an entry are stored next to each other.
+// Sums are computed modulo 2^(8*sizeof(S)): with 32-bit accumulators box sums are exact as long as the box
+// has less than 2^32/255 pixels (about 4096 x 4096), 64-bit accumulators have no practical limit.
+template<typename S> class IntegralImage {
+	int m_width = 0;
+	int m_height = 0;
+	int m_apron = 0;
+	size_t m_stride = 0;			// entries per row
+	vector<S> m_sums;
+
+public:
+	int getWidth() const { return m_width; }
+	int getHeight() const { return m_height; }
+	int getApron() const { return m_apron; }
+
+	// row-parallel prefix sums followed by column-parallel prefix sums; Skip is built like Clamp
+	void build(const fipImage& image, int apron, BorderMode border);
+
+	// sum of channel c over the box [x0,x1) x [y0,y1); the box may reach at most apron pixels beyond the image
+	S boxSum(int c, int x0, int y0, int x1, int y1) const {
+		const S *top = m_sums.data() + 4*((y0 + m_apron)*m_stride + m_apron);
+		const S *bottom = m_sums.data() + 4*((y1 + m_apron)*m_stride + m_apron);
+
+		return bottom[4*x1 + c] - bottom[4*x0 + c] - top[4*x1 + c] + top[4*x0 + c];
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+// Box filters on a summed-area table in O(1) per pixel, independent of the window size.
+// output must be a 32-bit image of the size of the table.
+
+// rounded mean of the (2*radius + 1)^2 window around every pixel, radius must not exceed the apron
+template<typename S> void boxFilter(const IntegralImage<S>& sat, fipImage& output, int radius);
+
+// edge detection with the hFilter/vFilter family of size fSize (+1/-1 in the rows resp. columns next to the center):
+// each response is the difference of two line sums, the result equals processParallel for every border mode.
+// The apron must be at least fSize/2.
+template<typename S> void processIntegral(const IntegralImage<S>& sat, fipImage& output, int fSize, BorderMode border, MagnitudeMode mag);
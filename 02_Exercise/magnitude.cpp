@@ -0,0 +1,231 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <emmintrin.h>
+#include "magnitude.h"
+
+////////////////////////////////////////////////////////////////////////
+// integer square root table for all squared magnitudes below 255^2
+class SqrtLUT {
+	static const int Size = 255*255 + 1;
+	BYTE m_table[Size];
+
+public:
+	SqrtLUT() {
+		int d = 0;
+		for(int i = 0; i < Size; i++) {
+			if ((d + 1)*(d + 1) <= i) d++;
+			m_table[i] = (BYTE)d;
+		}
+	}
+	BYTE operator()(int x, int y) const {
+		// components beyond 255 saturate anyway; clamping them keeps the squares from overflowing
+		x = min(abs(x), 255);
+		y = min(abs(y), 255);
+		return m_table[min(x*x + y*y, Size - 1)];
+	}
+};
+
+static const SqrtLUT s_sqrtLUT;
+
+////////////////////////////////////////////////////////////////////////
+static BYTE dist(int x, int y) {
+	int d = (int)sqrtf((float)(x*x) + (float)(y*y));
+	return (d < 256) ? d : 255;
+}
+
+////////////////////////////////////////////////////////////////////////
+static unsigned short dist16(int x, int y) {
+	int d = (int)sqrt((double)x*x + (double)y*y);
+	return (d < 65536) ? d : 65535;
+}
+
+////////////////////////////////////////////////////////////////////////
+MagnitudeMode parseMagnitudeMode(const char* name) {
+	if (strcmp(name, "exact") == 0) return MagnitudeMode::Exact;
+	if (strcmp(name, "lut") == 0) return MagnitudeMode::LUT;
+	if (strcmp(name, "l1") == 0) return MagnitudeMode::L1;
+	return MagnitudeMode::SIMD;
+}
+
+////////////////////////////////////////////////////////////////////////
+const char* magnitudeModeName(MagnitudeMode mag) {
+	switch(mag) {
+	case MagnitudeMode::Exact: return "exact";
+	case MagnitudeMode::LUT: return "lut";
+	case MagnitudeMode::L1: return "l1";
+	default: return "simd";
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// computes four magnitudes (one pixel) with SSE2
+static inline __m128i magnitudeSIMD(__m128i x, __m128i y) {
+	const __m128 fx = _mm_cvtepi32_ps(x);
+	const __m128 fy = _mm_cvtepi32_ps(y);
+
+	// squares are exact in float because |x|, |y| < 2^12
+	return _mm_cvttps_epi32(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(fx, fx), _mm_mul_ps(fy, fy))));
+}
+
+////////////////////////////////////////////////////////////////////////
+static inline __m128i magnitudeL1(__m128i x, __m128i y) {
+	const __m128i sx = _mm_srai_epi32(x, 31);
+	const __m128i sy = _mm_srai_epi32(y, 31);
+
+	return _mm_add_epi32(_mm_sub_epi32(_mm_xor_si128(x, sx), sx), _mm_sub_epi32(_mm_xor_si128(y, sy), sy));
+}
+
+////////////////////////////////////////////////////////////////////////
+// vectorized magnitude: four pixels per iteration, saturation to 255 by the pack instructions
+// n is the number of 4-int groups; alpha is or-ed into the output (0 for planar data)
+template<__m128i (*Op)(__m128i, __m128i)>
+static void magnitudeVector(const int *hC, const int *vC, BYTE *out, int n, int alphaMask = 0xFF000000) {
+	const __m128i alpha = _mm_set1_epi32(alphaMask);
+	int u = 0;
+
+	for(; u + 4 <= n; u += 4) {
+		const __m128i *h = reinterpret_cast<const __m128i*>(hC + 4*u);
+		const __m128i *v = reinterpret_cast<const __m128i*>(vC + 4*u);
+		const __m128i d0 = Op(_mm_loadu_si128(h + 0), _mm_loadu_si128(v + 0));
+		const __m128i d1 = Op(_mm_loadu_si128(h + 1), _mm_loadu_si128(v + 1));
+		const __m128i d2 = Op(_mm_loadu_si128(h + 2), _mm_loadu_si128(v + 2));
+		const __m128i d3 = Op(_mm_loadu_si128(h + 3), _mm_loadu_si128(v + 3));
+		const __m128i d = _mm_packus_epi16(_mm_packs_epi32(d0, d1), _mm_packs_epi32(d2, d3));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4*u), _mm_or_si128(d, alpha));
+	}
+	for(; u < n; u++) {
+		const __m128i d = Op(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hC + 4*u)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(vC + 4*u)));
+		const __m128i d8 = _mm_packus_epi16(_mm_packs_epi32(d, d), d);
+
+		*reinterpret_cast<int*>(out + 4*u) = _mm_cvtsi128_si32(_mm_or_si128(d8, alpha));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+void magnitude(const int *hC, const int *vC, BYTE *out, int n, MagnitudeMode mag) {
+	switch(mag) {
+	case MagnitudeMode::Exact:
+		for(int u = 0; u < n; u++) {
+			RGBQUAD *oC = reinterpret_cast<RGBQUAD*>(out + 4*u);
+			oC->rgbBlue = dist(hC[4*u], vC[4*u]);
+			oC->rgbGreen = dist(hC[4*u + 1], vC[4*u + 1]);
+			oC->rgbRed = dist(hC[4*u + 2], vC[4*u + 2]);
+			oC->rgbReserved = 255;
+		}
+		break;
+	case MagnitudeMode::LUT:
+		for(int u = 0; u < n; u++) {
+			RGBQUAD *oC = reinterpret_cast<RGBQUAD*>(out + 4*u);
+			oC->rgbBlue = s_sqrtLUT(hC[4*u], vC[4*u]);
+			oC->rgbGreen = s_sqrtLUT(hC[4*u + 1], vC[4*u + 1]);
+			oC->rgbRed = s_sqrtLUT(hC[4*u + 2], vC[4*u + 2]);
+			oC->rgbReserved = 255;
+		}
+		break;
+	case MagnitudeMode::L1:
+		magnitudeVector<magnitudeL1>(hC, vC, out, n);
+		break;
+	default:
+		magnitudeVector<magnitudeSIMD>(hC, vC, out, n);
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// groups of four consecutive pixels are processed like the four lanes of one interleaved pixel,
+// the last incomplete group is padded so that all pixels take the same vector operation
+template<__m128i (*Op)(__m128i, __m128i)>
+static void magnitudePlaneVector(const int *h, const int *v, BYTE *out, int n) {
+	const int n4 = n & ~3;
+
+	magnitudeVector<Op>(h, v, out, n4/4, 0);
+	if (n4 < n) {
+		int hT[4] = {}, vT[4] = {};
+		BYTE oT[4];
+
+		copy(h + n4, h + n, hT);
+		copy(v + n4, v + n, vT);
+		magnitudeVector<Op>(hT, vT, oT, 1, 0);
+		copy(oT, oT + n - n4, out + n4);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+void magnitudePlane(const int *h, const int *v, BYTE *out, int n, MagnitudeMode mag) {
+	switch(mag) {
+	case MagnitudeMode::Exact:
+		for(int u = 0; u < n; u++) out[u] = dist(h[u], v[u]);
+		break;
+	case MagnitudeMode::LUT:
+		for(int u = 0; u < n; u++) out[u] = s_sqrtLUT(h[u], v[u]);
+		break;
+	case MagnitudeMode::L1:
+		magnitudePlaneVector<magnitudeL1>(h, v, out, n);
+		break;
+	default:
+		magnitudePlaneVector<magnitudeSIMD>(h, v, out, n);
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// saturates four ints to [0,65535] and packs them to unsigned shorts in the lower half (SSE2 has no packus_epi32)
+static inline __m128i packUnsigned16(__m128i d) {
+	const __m128i limit = _mm_set1_epi32(65535);
+	const __m128i bias = _mm_set1_epi32(32768);
+	const __m128i over = _mm_cmpgt_epi32(d, limit);
+
+	d = _mm_or_si128(_mm_andnot_si128(over, d), _mm_and_si128(over, limit));
+	d = _mm_packs_epi32(_mm_sub_epi32(d, bias), _mm_setzero_si128());
+	return _mm_add_epi16(d, _mm_set1_epi16(-32768));
+}
+
+////////////////////////////////////////////////////////////////////////
+// four 16-bit magnitudes in double precision: bit-identical to dist16
+static inline __m128i magnitudeSIMD16(__m128i x, __m128i y) {
+	const __m128d xLo = _mm_cvtepi32_pd(x), yLo = _mm_cvtepi32_pd(y);
+	const __m128d xHi = _mm_cvtepi32_pd(_mm_srli_si128(x, 8)), yHi = _mm_cvtepi32_pd(_mm_srli_si128(y, 8));
+	const __m128i dLo = _mm_cvttpd_epi32(_mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(xLo, xLo), _mm_mul_pd(yLo, yLo))));
+	const __m128i dHi = _mm_cvttpd_epi32(_mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(xHi, xHi), _mm_mul_pd(yHi, yHi))));
+
+	return _mm_unpacklo_epi64(dLo, dHi);
+}
+
+////////////////////////////////////////////////////////////////////////
+template<__m128i (*Op)(__m128i, __m128i)>
+static void magnitudePlane16Vector(const int *h, const int *v, unsigned short *out, int n) {
+	int u = 0;
+
+	for(; u + 4 <= n; u += 4) {
+		const __m128i d = Op(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + u)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + u)));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + u), packUnsigned16(d));
+	}
+	if (u < n) {
+		int hT[4] = {}, vT[4] = {};
+		unsigned short oT[8];
+
+		copy(h + u, h + n, hT);
+		copy(v + u, v + n, vT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(oT), packUnsigned16(Op(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hT)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(vT)))));
+		copy(oT, oT + n - u, out + u);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+void magnitudePlane16(const int *h, const int *v, unsigned short *out, int n, MagnitudeMode mag) {
+	switch(mag) {
+	case MagnitudeMode::Exact:
+	case MagnitudeMode::LUT:
+		for(int u = 0; u < n; u++) out[u] = dist16(h[u], v[u]);
+		break;
+	case MagnitudeMode::L1:
+		magnitudePlane16Vector<magnitudeL1>(h, v, out, n);
+		break;
+	default:
+		magnitudePlane16Vector<magnitudeSIMD16>(h, v, out, n);
+		break;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "main.h"
+
+////////////////////////////////////////////////////////////////////////
+// Magnitude stage: combines horizontal and vertical filter responses to an 8-bit edge strength
+// Exact: scalar sqrtf (reference), SIMD: _mm_sqrt_ps (bit-identical to Exact),
+// LUT: integer square root table (bit-identical to Exact), L1: min(|x| + |y|, 255) (approximation)
+enum class MagnitudeMode { Exact, SIMD, LUT, L1 };
+
+MagnitudeMode parseMagnitudeMode(const char* name);
+const char* magnitudeModeName(MagnitudeMode mag);
+
+// hC and vC contain 4 ints per pixel (blue, green, red, unused); out receives n BGRA pixels with alpha 255
+void magnitude(const int *hC, const int *vC, BYTE *out, int n, MagnitudeMode mag);
+
+// planar variant: h and v contain one int per pixel of a single channel, out receives n bytes
+void magnitudePlane(const int *h, const int *v, BYTE *out, int n, MagnitudeMode mag);
+
+// 16-bit planar variant: saturation to 65535, the SIMD mode computes in double precision and LUT falls back to Exact
+void magnitudePlane16(const int *h, const int *v, unsigned short *out, int n, MagnitudeMode mag);
@@ -1,5 +1,21 @@
+#include <random>
+#include <cstdlib>
 #include "main.h"
 #include "ocl.h"
+#include "magnitude.h"
+#include "stream.h"
+#include "pipeline.h"
+#include "batch.h"
+#include "planar.h"
+#include "incremental.h"
+#include "integral.h"
+#include "convolve.h"
+#include "Kernel.h"
+#include "ImageBuffer.h"
+#include "ImageIO.h"
+#include "ImageCompare.h"
+#include "MemoryPool.h"
+#include "Runtime.h"
 
 ////////////////////////////////////////////////////////////////////////
 // prototypes
@@ -7,229 +23,424 @@ OCLData initOCL(const char* kernelFileName, const char* kernelName);
 void processOCL(OCLData& ocl, const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize);
 void processAMP(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, Stopwatch& sw);
 void processACC(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize);
+void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag);
 
 ////////////////////////////////////////////////////////////////////////
-static BYTE dist(int x, int y) {
-	int d = (int)sqrtf((float)(x*x) + (float)(y*y));
-	return (d < 256) ? d : 255;
+// compares the results of two backends but ignores a border of the given width; if they differ,
+// a heatmap of the differences is saved as diff<n>.png
+static bool verify(const char* label, const fipImage& im1, const fipImage& im2, int margin, int tolerance = 0) {
+	static int heatmaps = 0;
+	const ImageDiff diff = compareImages(im1, im2, margin, tolerance);
+
+	cout << label << ": " << diff << endl;
+	if (!diff.isEqual()) {
+		const string fileName = "diff" + to_string(++heatmaps) + ".png";
+		fipImage heatmap;
+
+		compareImages(im1, im2, margin, tolerance, &heatmap);
+		if (saveImage(heatmap, fileName.c_str())) cout << "heatmap of the differences: " << fileName << endl;
+	}
+	return diff.isEqual();
 }
 
 ////////////////////////////////////////////////////////////////////////
-static void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize) {
-	const int bypp = 4;
-	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getImageSize() == output.getImageSize());
-	assert(input.getBitsPerPixel() == bypp*8);
-
-	const size_t stride = input.getScanWidth();
-	const int fSizeD2 = fSize/2;
-
-	#pragma omp parallel for
-	for(int v = fSizeD2; v < (int)output.getHeight() - fSizeD2; v++) {
-		BYTE *iCenter = input.getScanLine(v) + bypp*fSizeD2;
-		BYTE *oPos = output.getScanLine(v) + bypp*fSizeD2;
-
-		for(size_t u = fSizeD2; u < output.getWidth() - fSizeD2; u++) {
-			int hC[3] = { 0, 0, 0 };
-			int vC[3] = { 0, 0, 0 };
-			int fi = 0;
-			BYTE *iPos = iCenter - fSizeD2*stride - bypp*fSizeD2;
-
-			for(int j = 0; j < fSize; j++) {
-				for(int i = 0; i < fSize; i++) {
-					const RGBQUAD *iC = reinterpret_cast<RGBQUAD*>(iPos);
-					int f = hFilter[fi];
-
-					hC[0] += f*iC->rgbBlue;
-					hC[1] += f*iC->rgbGreen;
-					hC[2] += f*iC->rgbRed;
-					f = vFilter[fi];
-					vC[0] += f*iC->rgbBlue;
-					vC[1] += f*iC->rgbGreen;
-					vC[2] += f*iC->rgbRed;
-					iPos += bypp;
-					fi++;
-				}
-				iPos += stride - bypp*fSize;
-			}
-			RGBQUAD *oC = reinterpret_cast<RGBQUAD*>(oPos);
-			oC->rgbBlue = dist(hC[0], vC[0]);
-			oC->rgbGreen = dist(hC[1], vC[1]);
-			oC->rgbRed = dist(hC[2], vC[2]);
-			oC->rgbReserved = 255;
-			iCenter += bypp;
-			oPos += bypp;
-		}
-	}
+// output image from the pool; skip mode leaves the border of fSize/2 pixels untouched, hence it has to hold the input pixels
+static shared_ptr<fipImage> createOutput(ImagePool& pool, const fipImage& input, BorderMode border, int fSize) {
+	shared_ptr<fipImage> output = pool.acquire(input);
+
+	if (border == BorderMode::Skip) copyBorder(input, *output, fSize/2);
+	return output;
 }
 
 ////////////////////////////////////////////////////////////////////////
-static bool equals(const fipImage& im1, const fipImage& im2, int fSize) {
-	assert(im1.getWidth() == im2.getWidth() && im1.getHeight() == im2.getHeight() && im1.getImageSize() == im2.getImageSize());
-	assert(im1.getBitsPerPixel() == 32);
-	const int fSizeD2 = fSize/2;
-
-	for(unsigned int i = fSizeD2; i < im1.getHeight() - fSizeD2; i++) {
-		COLORREF *row1 = reinterpret_cast<COLORREF*>(im1.getScanLine(i));
-		COLORREF *row2 = reinterpret_cast<COLORREF*>(im2.getScanLine(i));
-		for(unsigned int j = fSizeD2; j < im1.getWidth() - fSizeD2; j++) {
-			if (row1[j] != row2[j]) return false;
-		}
+// edge detection with built-in or loaded kernels: every applicable strategy is compared with the direct one,
+// the output is computed with the strategy chosen by the tuner; tuning decisions persist in tuning.txt
+static int processKernels(const char* spec, const char* inputName, const char* outputName, BorderMode border) {
+	const char* tuningFile = "tuning.txt";
+	const Strategy strategies[] = { Strategy::Separable, Strategy::Box, Strategy::SIMD, Strategy::OpenCL };
+	vector<Kernel> kernels;
+	MappedImage mapping;
+	fipImage image;
+	Stopwatch sw;
+
+	if (!parseKernels(spec, kernels)) {
+		cerr << "Unknown kernel or wrong kernel file: " << spec << endl;
+		return -2;
+	}
+	if (!loadImage(inputName, image, mapping)) {
+		cerr << "Image not found: " << inputName << endl;
+		return -3;
+	}
+	if (image.getImageType() != FIT_BITMAP || image.getBitsPerPixel() != 32) image.convertTo32Bits();
+
+	const Kernel& hKernel = kernels[0];
+	const Kernel vKernel = (kernels.size() > 1) ? kernels[1] : Kernel(hKernel.getSize());
+	OCLData ocl = initOCL("edges.cl", "edges");
+	KernelTuner tuner(&ocl);
+	fipImage reference(image), result(image);	// copies: skip mode leaves the input pixels at the border
+
+	tuner.load(tuningFile);
+	cout << "Edge detection with " << hKernel.getName() << " (" << hKernel.getShape() << ") and " << vKernel.getName() << " (" << vKernel.getShape() << ")" << endl;
+	cout << "Border mode " << borderModeName(border) << " on " << tuner.getDevice() << endl << endl;
+
+	cout << "Start " << strategyName(Strategy::Direct) << endl;
+	sw.Start();
+	convolve(Strategy::Direct, image, reference, hKernel, vKernel, border, MagnitudeMode::SIMD, &ocl);
+	sw.Stop();
+	const double directTime = sw.GetElapsedTimeMilliseconds();
+	cout << directTime << " ms" << endl << endl;
+
+	for(Strategy s: strategies) {
+		if (!isApplicable(s, image, hKernel, vKernel, border, MagnitudeMode::SIMD, &ocl)) continue;
+
+		cout << "Start " << strategyName(s) << endl;
+		sw.Start();
+		convolve(s, image, result, hKernel, vKernel, border, MagnitudeMode::SIMD, &ocl);
+		sw.Stop();
+		cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << directTime/sw.GetElapsedTimeMilliseconds() << endl;
+		verify((string("Direct and ") + strategyName(s)).c_str(), reference, result, 0, (s == Strategy::OpenCL) ? Tolerance : 0);
+		cout << endl;
+	}
+
+	const size_t decisions = tuner.getDecisions();
+	sw.Start();
+	tuner.process(image, result, hKernel, vKernel, border, MagnitudeMode::SIMD);
+	sw.Stop();
+	cout << "Tuner chose " << strategyName(tuner.select(image, result, hKernel, vKernel, border, MagnitudeMode::SIMD)) << ((tuner.getDecisions() > decisions) ? " after timing the candidates in " : " from the cache in ") << sw.GetElapsedTimeMilliseconds() << " ms" << endl;
+	verify("Direct and tuned strategy", reference, result, 0, Tolerance);
+	if (!tuner.save(tuningFile)) cerr << "Tuning decisions not saved: " << tuningFile << endl;
+
+	if (!saveImage(result, outputName)) {
+		cerr << "Image not saved: " << outputName << endl;
+		return -1;
 	}
-	return true;
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+static void printUsage(const char* program) {
+	cerr << "Usage: " << program << " [stream|pipeline|frames] filter-size input-file-name output-file-name [skip|clamp|mirror|wrap|zero] [band-rows|threshold|frame-count]" << endl;
+	cerr << "       " << program << " batch filter-size input-directory|list-file output-directory [skip|clamp|mirror|wrap|zero] [queue-depth]" << endl;
+	cerr << "       " << program << " kernel sobel|scharr|laplacian|prewitt<n>|gaussian<n>|box<n>|kernel-file input-file-name output-file-name [skip|clamp|mirror|wrap|zero]" << endl;
+	cerr << "       " << program << " convert input-file-name output-file-name" << endl;
+	cerr << "Files with the extension .rimg are memory-mapped raw images" << endl;
 }
 
 ////////////////////////////////////////////////////////////////////////
 int main(int argc, const char* argv[]) {
+	const char* program = argv[0];
+	bool stream = false, pipeline = false, batch = false, frames = false, kernels = false;
+
+	// conversion between raw image files and FreeImage formats
+	if (argc > 1 && strcmp(argv[1], "convert") == 0) {
+		MappedImage mapping;
+		fipImage image;
+
+		if (argc < 4) {
+			cerr << "Usage: " << program << " convert input-file-name output-file-name" << endl;
+			return -1;
+		}
+		if (!loadImage(argv[2], image, mapping)) {
+			cerr << "Image not found: " << argv[2] << endl;
+			return -3;
+		}
+		if (!saveImage(image, argv[3])) {
+			cerr << "Image not saved: " << argv[3] << endl;
+			return -1;
+		}
+		return 0;
+	}
+
+	// optional processing mode
+	if (argc > 1 && (strcmp(argv[1], "stream") == 0 || strcmp(argv[1], "pipeline") == 0 || strcmp(argv[1], "batch") == 0 || strcmp(argv[1], "frames") == 0 || strcmp(argv[1], "kernel") == 0)) {
+		stream = strcmp(argv[1], "stream") == 0;
+		pipeline = strcmp(argv[1], "pipeline") == 0;
+		batch = strcmp(argv[1], "batch") == 0;
+		frames = strcmp(argv[1], "frames") == 0;
+		kernels = strcmp(argv[1], "kernel") == 0;
+		argc--;
+		argv++;
+	}
 	if (argc < 4) {
-		cerr << "Usage: " << argv[0] << " filter-size input-file-name output-file-name" << endl;
+		printUsage(program);
 		return -1;
 	}
+
+	BorderMode border = BorderMode::Clamp;
+	if (argc > 4 && !parseBorderMode(argv[4], border)) {
+		cerr << "Unknown border mode: " << argv[4] << endl;
+		printUsage(program);
+		return -1;
+	}
+	if (kernels) return processKernels(argv[1], argv[2], argv[3], border);
+
 	int fSize = atoi(argv[1]);
-	if (fSize < 3 || fSize > 11 || (fSize & 1) == 0) {
-		cerr << "Wrong filter size. Filter size must be odd and between 3 and 9" << endl;
+	if (fSize < 3 || (fSize & 1) == 0) {
+		cerr << "Wrong filter size. Filter size must be odd and at least 3" << endl;
 		return -2;
 	}
 
+	Stopwatch sw;
+	double parTime;
+
+	// hFilter: +1 in the row above and -1 in the row below the center, vFilter: its transposition
+	const Kernel hKernel = Kernel::prewitt(fSize), vKernel = hKernel.transposed();
+	const int *hFilter = hKernel.data();
+	const int *vFilter = vKernel.data();
+
+	if (stream) {
+		// bounded-memory edge detection: band by band from input to output file
+		const int bandRows = (argc > 5) ? atoi(argv[5]) : 64;
+		unique_ptr<ScanlineReader> reader = openScanlineReader(argv[2]);
+
+		if (reader->getWidth() == 0) {
+			cerr << "Image not found: " << argv[2] << endl;
+			return -3;
+		}
+		unique_ptr<ScanlineWriter> writer = openScanlineWriter(argv[3], reader->getWidth(), reader->getHeight());
+
+		cout << "Streaming edge detection with filter size " << fSize << " and bands of " << bandRows << " rows" << endl;
+		sw.Start();
+		const bool ok = processStream(*reader, *writer, hFilter, vFilter, fSize, border, MagnitudeMode::SIMD, bandRows);
+		sw.Stop();
+		if (!ok) {
+			cerr << "Streaming failed: " << argv[2] << " -> " << argv[3] << endl;
+			return -1;
+		}
+		cout << sw.GetElapsedTimeMilliseconds() << " ms, band buffers = " << 2*4*(size_t)reader->getWidth()*(max(bandRows, fSize) + fSize - 1)/1024 << " KB" << endl;
+		return 0;
+	}
+
+	if (batch) {
+		// many images: decode, convolution and encode overlap in a bounded pipeline
+		const int depth = (argc > 5) ? atoi(argv[5]) : 2;
+		const vector<string> files = listBatchFiles(argv[2]);
+
+		if (files.empty()) {
+			cerr << "No images found: " << argv[2] << endl;
+			return -3;
+		}
+		cout << "Batch edge detection of " << files.size() << " images with filter size " << fSize << " and queue depth " << depth << endl;
+		const BatchStats stats = processBatch(files, argv[3], hFilter, vFilter, fSize, border, MagnitudeMode::SIMD, depth);
+		stats.print(cout);
+		return (stats.m_failed) ? -1 : 0;
+	}
+
+	MappedImage mapping;
 	fipImage image;
 
-	// load image
-	if (!image.load(argv[2])) {
+	// load image: raw images are mapped, hence a 32-bit raw image is used without any copy
+	if (!loadImage(argv[2], image, mapping)) {
 		cerr << "Image not found: " << argv[2] << endl;
 		return -3;
 	}
+	if (image.getImageType() != FIT_BITMAP || image.getBitsPerPixel() != 32) image.convertTo32Bits();
 
-	const int hFilter3[] = {
-		1, 1, 1,
-		0, 0, 0,
-	   -1,-1,-1,
-	};
-	const int vFilter3[] = {
-		1, 0,-1,
-		1, 0,-1,
-		1, 0,-1,
-	};
-	const int hFilter5[] = {
-		0, 0, 0, 0, 0,
-		1, 1, 1, 1, 1,
-		0, 0, 0, 0, 0,
-	   -1,-1,-1,-1,-1,
-	    0, 0, 0, 0, 0,
-	};
-	const int vFilter5[] = {
-		0, 1, 0,-1, 0,
-		0, 1, 0,-1, 0,
-		0, 1, 0,-1, 0,
-		0, 1, 0,-1, 0,
-		0, 1, 0,-1, 0,
-	};
-	const int hFilter7[] = {
-		0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1, 1, 1, 1,
-		0, 0, 0, 0, 0, 0, 0,
-	   -1,-1,-1,-1,-1,-1,-1,
-	    0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0,
-	};
-	const int vFilter7[] = {
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-	};
-	const int hFilter9[] = {
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1, 1, 1, 1, 1, 1,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-	   -1,-1,-1,-1,-1,-1,-1,-1,-1,
-	    0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-	};
-	const int vFilter9[] = {
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-	};
-	const int hFilter11[] = {
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	};
-	const int vFilter11[] = {
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-	};
+	// create output images: aligned pool buffers of the input's shape instead of copies of the input
+	ImagePool pool;
+	shared_ptr<fipImage> outputs[] = { createOutput(pool, image, border, fSize), createOutput(pool, image, border, fSize), createOutput(pool, image, border, fSize), createOutput(pool, image, border, fSize) };
+	fipImage &out1 = *outputs[0], &out2 = *outputs[1], &out3 = *outputs[2], &out4 = *outputs[3];
 
-	Stopwatch sw;
-	double parTime;
-	const int *hFilter;
-	const int *vFilter;
-
-	switch(fSize) {
-	case 3:
-		hFilter = hFilter3;
-		vFilter = vFilter3;
-		break;
-	case 5:
-		hFilter = hFilter5;
-		vFilter = vFilter5;
-		break;
-	case 7:
-		hFilter = hFilter7;
-		vFilter = vFilter7;
-		break;
-	case 9:
-		hFilter = hFilter9;
-		vFilter = vFilter9;
-		break;
-	case 11:
-		hFilter = hFilter11;
-		vFilter = vFilter11;
-		break;
+	if (pipeline) {
+		// blur, gradient, non-maximum suppression and threshold: fused tile by tile versus one pass per stage
+		const int threshold = (argc > 5) ? atoi(argv[5]) : 64;
+		const int w = image.getWidth(), h = image.getHeight();
+		FilterPipeline canny(border);
+		FilterPipeline edges(border);
+
+		canny.blur(3).edges(hFilter, vFilter, fSize, MagnitudeMode::SIMD).nonMaxSuppression().threshold(threshold);
+		edges.edges(hFilter, vFilter, fSize, MagnitudeMode::SIMD);
+		cout << "Pipeline: ";
+		canny.print(cout);
+		cout << endl << endl;
+
+		cout << "Start pipeline with one pass per stage" << endl;
+		sw.Start();
+		canny.runPasses(image, out2);
+		sw.Stop();
+		parTime = sw.GetElapsedTimeMilliseconds();
+		cout << parTime << " ms, estimated memory traffic = " << canny.getPassesTraffic(w, h)/(1024*1024) << " MB" << endl << endl;
+
+		cout << "Start fused pipeline" << endl;
+		sw.Start();
+		canny.run(image, out1);
+		sw.Stop();
+		cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime/sw.GetElapsedTimeMilliseconds() << ", estimated memory traffic = " << canny.getFusedTraffic(w, h)/(1024*1024) << " MB" << endl;
+		verify("Fused and multi-pass pipeline", out1, out2, 0);
+		cout << endl;
+
+		// processParallel is the reference implementation of the edges stage
+		cout << "Start OpenMP" << endl;
+		sw.Start();
+		processParallel(image, out3, hFilter, vFilter, fSize, border, MagnitudeMode::SIMD);
+		sw.Stop();
+		parTime = sw.GetElapsedTimeMilliseconds();
+		cout << parTime << " ms" << endl;
+		cout << "Start fused edges stage" << endl;
+		sw.Start();
+		edges.run(image, out4);
+		sw.Stop();
+		cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime/sw.GetElapsedTimeMilliseconds() << endl;
+		const int margin = (border == BorderMode::Clamp || border == BorderMode::Mirror || border == BorderMode::Zero) ? 0 : fSize/2;
+		verify("OpenMP and edges stage", out3, out4, margin);
+		cout << endl;
+
+		// save output image
+		if (!saveImage(out1, argv[3])) {
+			cerr << "Image not saved: " << argv[3] << endl;
+			return -1;
+		}
+		return 0;
 	}
 
-	// create output images
-	fipImage out1(image), out2(image), out3(image), out4(image);
+	if (frames) {
+		// frame sequences derived from the input: every frame inverts random 16x16 blocks covering the given share of the previous frame
+		const int frameCount = (argc > 5) ? max(atoi(argv[5]), 2) : 20;
+		const double changes[] = { 0.01, 0.02, 0.05, 0.1, 0.2 };
+		const int w = image.getWidth(), h = image.getHeight();
+		const int block = 16;
+		const int margin = (border == BorderMode::Skip) ? fSize/2 : 0;
+		mt19937 rng(1);
+
+		cout << "Incremental edge detection of " << frameCount << " frames with filter size " << fSize << " and border mode " << borderModeName(border) << endl << endl;
+		for(double change: changes) {
+			FrameStream frameStream(hFilter, vFilter, fSize, border, MagnitudeMode::SIMD);
+			fipImage frame(image);
+			double fullTime = 0, incTime = 0;
+			bool same = true;
+
+			for(int f = 0; f < frameCount; f++) {
+				if (f > 0) {
+					const int blocks = max(1, (int)(change*w*h/(block*block)));
 
-	cout << "Edge detection with filter size " << fSize << endl << endl;
+					for(int b = 0; b < blocks; b++) {
+						const int x0 = rng()%max(w - block, 1);
+						const int y0 = rng()%max(h - block, 1);
+
+						for(int y = y0; y < min(y0 + block, h); y++) {
+							BYTE *row = frame.getScanLine(y);
+							for(int x = 4*x0; x < 4*min(x0 + block, w); x++) {
+								if ((x & 3) != 3) row[x] = 255 - row[x];
+							}
+						}
+					}
+				}
+
+				// the first frame is computed completely by both variants
+				sw.Start();
+				processParallel(frame, out1, hFilter, vFilter, fSize, border, MagnitudeMode::SIMD);
+				sw.Stop();
+				if (f > 0) fullTime += sw.GetElapsedTimeMilliseconds();
+				sw.Start();
+				const fipImage& result = frameStream.process(frame);
+				sw.Stop();
+				if (f > 0) incTime += sw.GetElapsedTimeMilliseconds();
+				same = same && compareImages(out1, result, margin).isEqual();
+			}
+			cout << 100*change << " % changed per frame: full " << fullTime/(frameCount - 1) << " ms, incremental " << incTime/(frameCount - 1)
+				<< " ms per frame, speedup = " << fullTime/incTime << ", recomputed " << 100*frameStream.getRecomputedFraction() << " % of the pixels" << endl;
+			cout << boolalpha << "Full and incremental recomputation produce the same results: " << same << endl;
+		}
+		cout << endl;
+
+		// save output image
+		if (!saveImage(out1, argv[3])) {
+			cerr << "Image not saved: " << argv[3] << endl;
+			return -1;
+		}
+		return 0;
+	}
+
+	cout << "Edge detection with filter size " << fSize << " and border mode " << borderModeName(border) << endl << endl;
 
 	// process image on CPU in parallel and produce out1
 	cout << "Start OpenMP" << endl;
 	sw.Start();
-	processParallel(image, out1, hFilter, vFilter, fSize);
+	processParallel(image, out1, hFilter, vFilter, fSize, border, MagnitudeMode::SIMD);
 	sw.Stop();
 	parTime = sw.GetElapsedTimeMilliseconds();
 	cout << parTime << " ms" << endl << endl;
-	
+
+	// benchmark and validate the magnitude stage against the exact scalar dist
+	{
+		const MagnitudeMode modes[] = { MagnitudeMode::Exact, MagnitudeMode::SIMD, MagnitudeMode::LUT, MagnitudeMode::L1 };
+		shared_ptr<fipImage> exactImage = createOutput(pool, image, border, fSize), resultImage = createOutput(pool, image, border, fSize);
+		fipImage &exact = *exactImage, &result = *resultImage;
+		double exactTime = 0;
+
+		for(MagnitudeMode mag: modes) {
+			fipImage& out = (mag == MagnitudeMode::Exact) ? exact : result;
+
+			cout << "Start OpenMP with " << magnitudeModeName(mag) << " magnitude" << endl;
+			sw.Start();
+			processParallel(image, out, hFilter, vFilter, fSize, border, mag);
+			sw.Stop();
+			if (mag == MagnitudeMode::Exact) {
+				exactTime = sw.GetElapsedTimeMilliseconds();
+				cout << exactTime << " ms" << endl;
+			} else {
+				cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << exactTime/sw.GetElapsedTimeMilliseconds() << ", difference to exact: " << compareImages(exact, out) << endl;
+			}
+		}
+		cout << endl;
+	}
+
+	// planar layout: the conversions pay off once the faster planar convolution has saved their cost
+	{
+		PlanarImage planarIn(fSize/2), planarOut;
+		shared_ptr<fipImage> resultImage = pool.acquire(image);
+		fipImage& result = *resultImage;
+
+		cout << "Start OpenMP on planes" << endl;
+		sw.Start();
+		planarIn.deinterleave(image, border);
+		sw.Stop();
+		double convTime = sw.GetElapsedTimeMilliseconds();
+		sw.Start();
+		processPlanar(planarIn, planarOut, hFilter, vFilter, fSize, border, MagnitudeMode::SIMD);
+		sw.Stop();
+		const double planarTime = sw.GetElapsedTimeMilliseconds();
+		sw.Start();
+		planarOut.interleave(result);
+		sw.Stop();
+		convTime += sw.GetElapsedTimeMilliseconds();
+
+		cout << planarTime << " ms, speedup = " << parTime/planarTime << ", conversions = " << convTime << " ms" << endl;
+		if (planarTime < parTime) {
+			cout << "conversions amortized after " << (int)ceil(convTime/(parTime - planarTime)) << " filter passes on the same planes" << endl;
+		} else {
+			cout << "conversions not amortized: planar convolution is not faster" << endl;
+		}
+		verify("OpenMP and OpenMP on planes", out1, result, 0);
+		cout << endl;
+	}
+
+	// summed-area table: built once, afterwards every box filter costs the same per pixel regardless of its size
+	{
+		const int radii[] = { 1, 4, 16, 64 };
+		IntegralImage<uint32_t> sat;
+		shared_ptr<fipImage> resultImage = createOutput(pool, image, border, fSize);
+		fipImage& result = *resultImage;
+
+		cout << "Start summed-area table" << endl;
+		sw.Start();
+		sat.build(image, radii[3], border);
+		sw.Stop();
+		const double buildTime = sw.GetElapsedTimeMilliseconds();
+		sw.Start();
+		processIntegral(sat, result, fSize, border, MagnitudeMode::SIMD);
+		sw.Stop();
+		cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime/sw.GetElapsedTimeMilliseconds() << ", table = " << buildTime << " ms" << endl;
+		verify("OpenMP and summed-area table", out1, result, 0);
+		for(int radius: radii) {
+			sw.Start();
+			boxFilter(sat, result, radius);
+			sw.Stop();
+			cout << "box mean " << 2*radius + 1 << "x" << 2*radius + 1 << ": " << sw.GetElapsedTimeMilliseconds() << " ms" << endl;
+		}
+		cout << endl;
+	}
+
 	// process image on GPU with OpenCL and produce out2
 	OCLData ocl = initOCL("edges.cl", "edges");
 	cout << endl << "Start OpenCL on GPU" << endl;
@@ -237,9 +448,95 @@ int main(int argc, const char* argv[]) {
 	processOCL(ocl, image, out2, hFilter, vFilter, fSize);
 	sw.Stop();
 	cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime/sw.GetElapsedTimeMilliseconds() << endl;
+	sw.Start();
+	processOCL(ocl, image, out2, hFilter, vFilter, fSize);
+	sw.Stop();
+	cout << "again with the device resources of the first run: " << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime/sw.GetElapsedTimeMilliseconds() << endl;
+
+	// compare out1 with out2: OpenCL clamps to the edge, hence the full frame is comparable in clamp mode only
+	const int margin = (border == BorderMode::Clamp) ? 0 : fSize/2;
+	verify("OpenMP and OpenCL on GPU", out1, out2, margin, Tolerance);
+	cout << endl;
+
+	// throughput of a sequence of images: blocking calls versus the asynchronous pipeline with overlapped transfers
+	{
+		const int images = 12;
+		OCLPipeline oclPipeline(ocl, hFilter, vFilter, fSize);
+		shared_ptr<fipImage> results[OCLPipeline::Depth];
+		cl::Event done[OCLPipeline::Depth];
+
+		for(shared_ptr<fipImage>& result: results) result = pool.acquire(image);
 
-	// compare out1 with out2
-	cout << boolalpha << "OpenMP and OpenCL on GPU produce the same results: " << equals(out1, out2, fSize) << endl << endl;
+		// device timestamps per stage: the host overhead is the time the device was idle
+		OCLProfiler syncProfile, asyncProfile;
+
+		cout << "Start OpenCL on GPU with " << images << " images" << endl;
+		ocl.m_profiler = &syncProfile;
+		sw.Start();
+		for(int i = 0; i < images; i++) processOCL(ocl, image, *results[i%OCLPipeline::Depth], hFilter, vFilter, fSize);
+		sw.Stop();
+		const double syncTime = sw.GetElapsedTimeMilliseconds();
+		cout << syncTime << " ms, " << 1000*images/syncTime << " images/s" << endl;
+		syncProfile.print(cout, syncTime);
+		OCLMemoryPool::get().print(cout);
+
+		cout << "Start asynchronous OpenCL on GPU with " << images << " images" << endl;
+		ocl.m_profiler = &asyncProfile;
+		sw.Start();
+		for(int i = 0; i < images; i++) {
+			const int k = i%OCLPipeline::Depth;
+
+			// the output of image i - Depth must have arrived before it is overwritten
+			if (done[k]()) done[k].wait();
+			done[k] = oclPipeline.process(image, *results[k]);
+		}
+		oclPipeline.finish();
+		sw.Stop();
+		ocl.m_profiler = nullptr;
+		cout << sw.GetElapsedTimeMilliseconds() << " ms, " << 1000*images/sw.GetElapsedTimeMilliseconds() << " images/s, speedup = " << syncTime/sw.GetElapsedTimeMilliseconds() << endl;
+		asyncProfile.print(cout, sw.GetElapsedTimeMilliseconds());
+
+		// timeline of the overlapped stages, e.g. for chrome://tracing
+		string trace;
+		if (getEnvironment("OCL_TRACE", trace) && asyncProfile.saveTrace(trace.c_str())) cout << "trace saved to " << trace << endl;
+		verify("OpenCL and asynchronous OpenCL on GPU", out2, *results[0], 0);
+		cout << endl;
+	}
+
+	// other pixel formats: same edge detection with less memory traffic
+	{
+		fipImage gray8(image), gray16(image), bgr24(image);
+		gray8.convertToGrayscale();
+		gray16.convertToUINT16();
+		bgr24.convertTo24Bits();
+		const fipImage* formats[] = { &gray8, &gray16, &bgr24 };
+		const char* names[] = { "8-bit gray", "16-bit gray", "24-bit BGR" };
+
+		for(int i = 0; i < 3; i++) {
+			const fipImage& in = *formats[i];
+			shared_ptr<fipImage> resultImage = createOutput(pool, in, border, fSize);
+			fipImage& result = *resultImage;
+
+			cout << "Start OpenMP on " << names[i] << endl;
+			sw.Start();
+			processParallel(in, result, hFilter, vFilter, fSize, border, MagnitudeMode::SIMD);
+			sw.Stop();
+			cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime/sw.GetElapsedTimeMilliseconds() << ", image size = " << in.getImageSize()/1024 << " KB instead of " << image.getImageSize()/1024 << " KB" << endl;
+			// OpenCL 1.2 has no 24-bit image format
+			if (in.getBitsPerPixel() != 24) {
+				shared_ptr<fipImage> resultOCLImage = pool.acquire(in);
+				fipImage& resultOCL = *resultOCLImage;
+
+				cout << "Start OpenCL on GPU on " << names[i] << endl;
+				sw.Start();
+				processOCL(ocl, in, resultOCL, hFilter, vFilter, fSize);
+				sw.Stop();
+				cout << sw.GetElapsedTimeMilliseconds() << " ms" << endl;
+				verify("OpenMP and OpenCL on GPU", result, resultOCL, margin, Tolerance);
+			}
+		}
+		cout << endl;
+	}
 
 	// process image on GPU with AMP and produce out3
 	//cout << "Start AMP on GPU" << endl;
@@ -250,14 +547,16 @@ int main(int argc, const char* argv[]) {
 
 #ifdef FAST_MATH
 	// compare out2 with out3
-	//cout << boolalpha << "OpenCL on GPU and AMP produce the same results: " << equals(out2, out3, fSize) << endl << endl; // should return true if AMP uses fast_math::sqrtf
+	//verify("OpenCL on GPU and AMP", out2, out3, fSize/2, Tolerance); // should return true if AMP uses fast_math::sqrtf
 #else
 	// compare out1 with out3
-	//cout << boolalpha << "OpenMP and AMP produce the same results: " << equals(out1, out3, fSize) << endl << endl; // should return true if AMP uses precise_math::sqrtf
+	//verify("OpenMP and AMP", out1, out3, fSize/2, Tolerance); // should return true if AMP uses precise_math::sqrtf
 #endif
 	
+	cout << "Image pool: " << pool.getAllocations() << " allocations, " << pool.getReuses() << " reuses" << endl << endl;
+
 	// save output image
-	if (!out1.save(argv[3])) {
+	if (!saveImage(out1, argv[3])) {
 		cerr << "Image not saved: " << argv[3] << endl;
 		return -1;
 	}
@@ -9,6 +9,56 @@ using namespace std;
 
 //#define FAST_MATH
 
+// channel tolerance when comparing results of backends with approximate square roots
+#ifdef FAST_MATH
+const int Tolerance = 1;
+#else
+const int Tolerance = 0;
+#endif
+
 #ifndef WIN32
 typedef unsigned long COLORREF;
-#endif
\ No newline at end of file
+#endif
+
+////////////////////////////////////////////////////////////////////////
+// Border handling of the CPU convolution engine
+// Skip leaves the outer fSize/2 pixels untouched, Clamp corresponds to CL_ADDRESS_CLAMP_TO_EDGE,
+// Mirror reflects at the edge (edge pixel repeated), Wrap repeats the image and Zero treats outside pixels as black
+enum class BorderMode { Skip, Clamp, Mirror, Wrap, Zero };
+
+////////////////////////////////////////////////////////////////////////
+// maps coordinate i to [0,n) according to the border mode; returns -1 if the pixel has to be treated as zero
+inline int borderIndex(int i, int n, BorderMode border) {
+	if (i >= 0 && i < n) return i;
+
+	switch(border) {
+	case BorderMode::Clamp:
+		return (i < 0) ? 0 : n - 1;
+	case BorderMode::Mirror:
+		do {
+			i = (i < 0) ? -i - 1 : 2*n - i - 1;
+		} while(i < 0 || i >= n);
+		return i;
+	case BorderMode::Wrap:
+		i %= n;
+		return (i < 0) ? i + n : i;
+	default:
+		return -1;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// Rectangle [m_x0,m_x1) x [m_y0,m_y1) of pixels
+struct Region {
+	int m_x0, m_y0, m_x1, m_y1;
+
+	bool isEmpty() const { return m_x0 >= m_x1 || m_y0 >= m_y1; }
+	int getArea() const { return isEmpty() ? 0 : (m_x1 - m_x0)*(m_y1 - m_y0); }
+};
+
+// false for unknown names
+bool parseBorderMode(const char* name, BorderMode& border);
+const char* borderModeName(BorderMode border);
+
+// 8-bit gray, 16-bit gray (FIT_UINT16), 24-bit BGR and 32-bit BGRA images are processed without conversion
+bool isSupportedFormat(const fipImage& image);
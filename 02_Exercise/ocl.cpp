@@ -1,106 +1,68 @@
-#include <fstream>
 #include <string>
 #include <vector>
-#include <utility>
+#include <algorithm>
 #include "main.h"
 #include "ocl.h"
+#include "Runtime.h"
+#include "WorkGroupTuner.h"
+#include "MemoryPool.h"
+#include "magnitude.h"
 
 ////////////////////////////////////////////////////////////////////////
-// TODO: adapt for choosing GPU or CPU
+// prototypes
+void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag);
+
+////////////////////////////////////////////////////////////////////////
+// fastest OpenCL device of the runtime; without a device or kernel the OCLData stays empty and processOCL
+// runs the OpenMP implementation
 OCLData initOCL(const char* kernelFileName, const char* kernelName) {
 	OCLData ocl;
-	vector<cl::Platform> platforms;
-	vector<cl::Device> devices;
-
-	cout << "**************************************************************************" << endl;
-	try {
-		// discover all available platforms
-		cl::Platform::get(&platforms);
-		if (platforms.empty()) {
-			cerr << "Error: no OpenCL platform available" << endl;
-			return ocl;
-		}
-
-		string name, profile, version;
-		
-		for(cl::Platform& p: platforms) {
-			p.getInfo(CL_PLATFORM_NAME, &name);
-			p.getInfo(CL_PLATFORM_PROFILE, &profile);
-			p.getInfo(CL_PLATFORM_VERSION, &version);
-
-			vector<cl::Device> devs;
-
-			try {
-				// get GPUs of this platform
-				p.getDevices(CL_DEVICE_TYPE_GPU, &devs);
-
-			} catch(cl::Error&) {
-				// there is no GPU on this platform
-			}
+	OCLRuntime& runtime = OCLRuntime::get();
+	OCLDevice *dev = runtime.fastest();
 
-			if (!devs.empty()) {
-				// show platform
-				cout << "Platform " << name << " (" << version << ", " << profile << ")" << endl;
-
-				// discover all available GPUs on this platform
-				for(cl::Device& dev: devs) {
-					// get and show device information
-					dev.getInfo(CL_DEVICE_NAME, &name);
-					cl_uint maxComputeUnits;		dev.getInfo(CL_DEVICE_MAX_COMPUTE_UNITS, &maxComputeUnits);
-					cl_uint maxDims;				dev.getInfo(CL_DEVICE_MAX_WORK_ITEM_DIMENSIONS, &maxDims);
-					vector<size_t> workitemSize;	dev.getInfo(CL_DEVICE_MAX_WORK_ITEM_SIZES, &workitemSize);
-					size_t workgroupSize;			dev.getInfo(CL_DEVICE_MAX_WORK_GROUP_SIZE, &workgroupSize); // product of all dimensions
-					cl_ulong localMemSize;			dev.getInfo(CL_DEVICE_LOCAL_MEM_SIZE, &localMemSize);
-					cout << name << endl;
-					cout << "Max. Compute Units: " << maxComputeUnits << ", Max. Dimensions: " << maxDims << " [" << workitemSize[0] << "," << workitemSize[1] << "," << workitemSize[2] << "]" << endl;
-					cout << "Max. Work Group Size: " << workgroupSize << ", Max. Local Mem Size: " << localMemSize << endl << endl;
-				}
-
-				if (devices.empty()) {
-					// create s_context and command s_queue for the first GPU
-					cl::Device& dev = devs.front();
-					cl_context_properties cps[] = { CL_CONTEXT_PLATFORM, (cl_context_properties)(p)(), 0 };
-
-					ocl.m_context = cl::Context(CL_DEVICE_TYPE_GPU, cps);
-					ocl.m_queue = cl::CommandQueue(ocl.m_context, dev);
-
-					// add first device
-					devices.push_back(dev);
-				}
-			}
-		}
-
-		// read source file
-		ifstream file(kernelFileName);
-		if (!file.good()) {
-			perror("Error");
-			return ocl;
-		}
-		string prog(istreambuf_iterator<char>(file), (istreambuf_iterator<char>()));	// read in file and store it in string prog
-		file.close();
-		cl::Program::Sources progSource(1, make_pair(prog.c_str(), prog.length() + 1));	// create source code object
-
-		// compile and execute s_kernel code
-		cl::Program program(ocl.m_context, progSource);									// create program object
-		program.build(devices);															// build the program for given devices
-		ocl.m_kernel = cl::Kernel(program, kernelName);									// create the s_kernel: must be the name of the s_kernel in the cl file
-
-	} catch(cl::Error& err) {
-		cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
+	if (dev) {
+		ocl.m_context = dev->m_context;
+		ocl.m_queue = dev->m_queue;
+		ocl.m_kernel = runtime.getKernel(*dev, kernelFileName, kernelName);
 	}
-	cout << "**************************************************************************" << endl;
+	printBackend(cout, kernelName, ocl.m_kernel() ? dev : nullptr, "OpenMP with SIMD magnitude");
 	return ocl;
 }
 
+////////////////////////////////////////////////////////////////////////
+// OpenCL image format of 8-bit gray, 16-bit gray and 32-bit BGRA images; OpenCL has no 24-bit format
+static bool imageFormat(const fipImage& image, cl::ImageFormat& format, cl_uint& maxValue) {
+	format.image_channel_order = CL_BGRA;
+	format.image_channel_data_type = CL_UNSIGNED_INT8;
+	maxValue = 255;
+	if (image.getImageType() == FIT_UINT16) {
+		format.image_channel_order = CL_R;
+		format.image_channel_data_type = CL_UNSIGNED_INT16;
+		maxValue = 65535;
+		return true;
+	}
+	switch(image.getBitsPerPixel()) {
+	case 8: format.image_channel_order = CL_R; return true;
+	case 32: return true;
+	default: return false;
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////
 void processOCL(OCLData& ocl, const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize) {
-	const int bypp = 4;
 	const size_t w = input.getWidth();
 	const size_t h = input.getHeight();
-	assert(w == output.getWidth() && h == output.getHeight() && input.getImageSize() == output.getImageSize());
-	assert(input.getBitsPerPixel() == bypp*8);
+	assert(w == output.getWidth() && h == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
+	assert(input.getImageType() == output.getImageType());
 	const size_t stride = input.getScanWidth();
+	const size_t oStride = output.getScanWidth();
 	const int fSize2 = fSize*fSize;
+
+	// native fallback with the border handling of the sampler
+	if (!ocl.m_kernel()) {
+		processParallel(input, output, hFilter, vFilter, fSize, BorderMode::Clamp, MagnitudeMode::SIMD);
+		return;
+	}
 	
 	cl::size_t<3> origin;
 	cl::size_t<3> region; 
@@ -111,38 +73,185 @@ void processOCL(OCLData& ocl, const fipImage& input, fipImage& output, const int
 	try {
 		// the image format describes the properties of each pixel
 		cl::ImageFormat format;
-		format.image_channel_order = CL_BGRA;
-		format.image_channel_data_type = CL_UNSIGNED_INT8;
+		cl_uint maxValue;
+
+		if (!imageFormat(input, format, maxValue)) {
+			cerr << "OpenCL error: unsupported image format with " << input.getBitsPerPixel() << " bits per pixel, switched to OpenMP" << endl;
+			processParallel(input, output, hFilter, vFilter, fSize, BorderMode::Clamp, MagnitudeMode::SIMD);
+			return;
+		}
+
+		// create sampler object once
+		if (!ocl.m_sampler()) ocl.m_sampler = cl::Sampler(ocl.m_context, CL_FALSE, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST); // on CPU must be not CL_ADDRESS_NONE
 
-		// create sampler object
-		cl::Sampler sampler(ocl.m_context, CL_FALSE, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST); // on CPU must be not CL_ADDRESS_NONE
+		// images of the pool: they return to it at the end of the call, all commands are blocking
+		shared_ptr<cl::Image2D> source = OCLMemoryPool::get().acquireImage(ocl.m_context, CL_MEM_READ_ONLY, format, region[0], region[1]);
+		shared_ptr<cl::Image2D> dest = OCLMemoryPool::get().acquireImage(ocl.m_context, CL_MEM_WRITE_ONLY, format, region[0], region[1]);
 
-		// create space for the images
-		cl::Image2D source(ocl.m_context, CL_MEM_READ_ONLY, format, region[0], region[1], 0);
-		cl::Image2D dest (ocl.m_context, CL_MEM_WRITE_ONLY, format, region[0], region[1], 0);
+		// create space for the filters if the filter size has changed
+		if (!ocl.m_hFilter() || fSize != ocl.m_fSize) {
+			ocl.m_hFilter = cl::Buffer(ocl.m_context, CL_MEM_READ_ONLY, fSize2*sizeof(int));
+			ocl.m_vFilter = cl::Buffer(ocl.m_context, CL_MEM_READ_ONLY, fSize2*sizeof(int));
+			ocl.m_fSize = fSize;
+			ocl.m_filters.clear();
+		}
 
-		// create space for the filters
-		cl::Buffer hor(ocl.m_context, CL_MEM_READ_ONLY, fSize2*sizeof(int));
-		cl::Buffer ver(ocl.m_context, CL_MEM_READ_ONLY, fSize2*sizeof(int));
+		// write the filters to the device if they have changed
+		if (ocl.m_filters.empty() || !equal(hFilter, hFilter + fSize2, ocl.m_filters.begin()) || !equal(vFilter, vFilter + fSize2, ocl.m_filters.begin() + fSize2)) {
+			ocl.m_filters.assign(hFilter, hFilter + fSize2);
+			ocl.m_filters.insert(ocl.m_filters.end(), vFilter, vFilter + fSize2);
+			ocl.m_queue.enqueueWriteBuffer(ocl.m_hFilter, CL_TRUE, 0, fSize2*sizeof(int), hFilter);
+			ocl.m_queue.enqueueWriteBuffer(ocl.m_vFilter, CL_TRUE, 0, fSize2*sizeof(int), vFilter);
+		}
 
-		// write buffers to device
-		ocl.m_queue.enqueueWriteImage(source, CL_TRUE, origin, region, stride, 0, input.getScanLine(0));
-		ocl.m_queue.enqueueWriteBuffer(hor, CL_TRUE, 0, fSize2*sizeof(int), hFilter);
-		ocl.m_queue.enqueueWriteBuffer(ver, CL_TRUE, 0, fSize2*sizeof(int), vFilter);
+		// write image to device
+		cl::Event event;
+		ocl.m_queue.enqueueWriteImage(*source, CL_TRUE, origin, region, stride, 0, input.getScanLine(0), nullptr, &event);
+		profile(ocl.m_profiler, event, "write image", OCLProfiler::Upload, stride*h);
 
 		// set the s_kernel arguments
-		ocl.m_kernel.setArg(0, source);
-		ocl.m_kernel.setArg(1, dest);
-		ocl.m_kernel.setArg(2, hor);
-		ocl.m_kernel.setArg(3, ver);
+		ocl.m_kernel.setArg(0, *source);
+		ocl.m_kernel.setArg(1, *dest);
+		ocl.m_kernel.setArg(2, ocl.m_hFilter);
+		ocl.m_kernel.setArg(3, ocl.m_vFilter);
 		ocl.m_kernel.setArg(4, fSize);
-		ocl.m_kernel.setArg(5, sampler);
+		ocl.m_kernel.setArg(5, ocl.m_sampler);
+		ocl.m_kernel.setArg(6, maxValue);
 
-		// run the kernels
-		ocl.m_queue.enqueueNDRangeKernel(ocl.m_kernel, cl::NullRange, cl::NDRange(region[0], region[1]), cl::NullRange);
+		// run the kernels with the tuned work-group size
+		WorkGroupTuner::get().enqueue(ocl.m_queue, ocl.m_kernel, region[0], region[1], nullptr, &event);
+		profile(ocl.m_profiler, event, "edges", OCLProfiler::Kernel);
 
 		// read the output buffer back to the host
-		ocl.m_queue.enqueueReadImage(dest, CL_TRUE, origin, region, stride, 0, output.getScanLine(0));
+		ocl.m_queue.enqueueReadImage(*dest, CL_TRUE, origin, region, oStride, 0, output.getScanLine(0), nullptr, &event);
+		profile(ocl.m_profiler, event, "read image", OCLProfiler::Download, oStride*h);
+
+	} catch(cl::Error& err) {
+		// the output is computed by the native implementation; the filters on the device may be incomplete
+		cerr << "OpenCL error: " << err.what() << "(" << err.err() << "), switched to OpenMP" << endl;
+		ocl.m_filters.clear();
+		processParallel(input, output, hFilter, vFilter, fSize, BorderMode::Clamp, MagnitudeMode::SIMD);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+OCLPipeline::OCLPipeline(OCLData& ocl, const int *hFilter, const int *vFilter, int fSize)
+	: m_ocl(ocl), m_fSize(fSize)
+{
+	const size_t fSize2 = fSize*fSize;
+
+	// native fallback: the images are processed synchronously by processOCL
+	m_filters.assign(hFilter, hFilter + fSize2);
+	m_filters.insert(m_filters.end(), vFilter, vFilter + fSize2);
+	if (!ocl.m_kernel()) return;
+
+	try {
+		const cl::Device dev = ocl.m_queue.getInfo<CL_QUEUE_DEVICE>();
+
+		m_upload = cl::CommandQueue(ocl.m_context, dev, CL_QUEUE_PROFILING_ENABLE);
+		m_compute = cl::CommandQueue(ocl.m_context, dev, CL_QUEUE_PROFILING_ENABLE);
+		m_download = cl::CommandQueue(ocl.m_context, dev, CL_QUEUE_PROFILING_ENABLE);
+		m_sampler = cl::Sampler(ocl.m_context, CL_FALSE, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST);
+		m_hFilter = cl::Buffer(ocl.m_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, fSize2*sizeof(int), const_cast<int*>(hFilter));
+		m_vFilter = cl::Buffer(ocl.m_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, fSize2*sizeof(int), const_cast<int*>(vFilter));
+
+	} catch(cl::Error& err) {
+		cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+cl::Event OCLPipeline::process(const fipImage& input, fipImage& output) {
+	const size_t w = input.getWidth();
+	const size_t h = input.getHeight();
+	assert(w == output.getWidth() && h == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
+	assert(input.getImageType() == output.getImageType());
+	cl::Event uploaded, computed, downloaded;
+
+	if (!m_ocl.m_kernel()) {
+		processOCL(m_ocl, input, output, m_filters.data(), m_filters.data() + m_fSize*m_fSize, m_fSize);
+		return downloaded;
+	}
+
+	cl::size_t<3> origin;
+	cl::size_t<3> region;
+	region[0] = w;
+	region[1] = h;
+	region[2] = 1;
+
+	try {
+		cl::ImageFormat format;
+
+		if (!imageFormat(input, format, m_maxValue)) {
+			cerr << "OpenCL error: unsupported image format with " << input.getBitsPerPixel() << " bits per pixel, switched to OpenMP" << endl;
+			processParallel(input, output, m_filters.data(), m_filters.data() + m_fSize*m_fSize, m_fSize, BorderMode::Clamp, MagnitudeMode::SIMD);
+			return downloaded;
+		}
+
+		// new shape: the images in flight have to be completed before the device images are replaced
+		if (!m_slots[0].m_source() || w != m_width || h != m_height || format.image_channel_order != m_format.image_channel_order
+			|| format.image_channel_data_type != m_format.image_channel_data_type) {
+			finish();
+			for(Slot& slot: m_slots) {
+				slot.m_source = cl::Image2D(m_ocl.m_context, CL_MEM_READ_ONLY, format, w, h, 0);
+				slot.m_dest = cl::Image2D(m_ocl.m_context, CL_MEM_WRITE_ONLY, format, w, h, 0);
+				slot.m_computed = slot.m_downloaded = cl::Event();
+			}
+			m_width = w;
+			m_height = h;
+			m_format = format;
+		}
+
+		Slot& slot = m_slots[m_next];
+		m_next = (m_next + 1)%Depth;
+
+		// upload after the previous kernel on this slot has read its source
+		vector<cl::Event> waitUpload, waitCompute;
+		if (slot.m_computed()) waitUpload.push_back(slot.m_computed);
+		m_upload.enqueueWriteImage(slot.m_source, CL_FALSE, origin, region, input.getScanWidth(), 0, input.getScanLine(0), &waitUpload, &uploaded);
+		profile(m_ocl.m_profiler, uploaded, "write image", OCLProfiler::Upload, input.getScanWidth()*h);
+
+		// kernel after the upload and after the previous download of this slot's destination; the arguments are
+		// captured when the kernel is enqueued, hence one kernel object serves all slots
+		waitCompute.push_back(uploaded);
+		if (slot.m_downloaded()) waitCompute.push_back(slot.m_downloaded);
+		m_ocl.m_kernel.setArg(0, slot.m_source);
+		m_ocl.m_kernel.setArg(1, slot.m_dest);
+		m_ocl.m_kernel.setArg(2, m_hFilter);
+		m_ocl.m_kernel.setArg(3, m_vFilter);
+		m_ocl.m_kernel.setArg(4, m_fSize);
+		m_ocl.m_kernel.setArg(5, m_sampler);
+		m_ocl.m_kernel.setArg(6, m_maxValue);
+		WorkGroupTuner::get().enqueue(m_compute, m_ocl.m_kernel, w, h, &waitCompute, &computed);
+		profile(m_ocl.m_profiler, computed, "edges", OCLProfiler::Kernel);
+
+		// download after the kernel
+		vector<cl::Event> waitDownload(1, computed);
+		m_download.enqueueReadImage(slot.m_dest, CL_FALSE, origin, region, output.getScanWidth(), 0, output.getScanLine(0), &waitDownload, &downloaded);
+		profile(m_ocl.m_profiler, downloaded, "read image", OCLProfiler::Download, output.getScanWidth()*h);
+
+		// start the work on all queues
+		m_upload.flush();
+		m_compute.flush();
+		m_download.flush();
+		slot.m_computed = computed;
+		slot.m_downloaded = downloaded;
+
+	} catch(cl::Error& err) {
+		// this image is computed synchronously by the native implementation
+		cerr << "OpenCL error: " << err.what() << "(" << err.err() << "), switched to OpenMP" << endl;
+		processParallel(input, output, m_filters.data(), m_filters.data() + m_fSize*m_fSize, m_fSize, BorderMode::Clamp, MagnitudeMode::SIMD);
+		downloaded = cl::Event();
+	}
+	return downloaded;
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLPipeline::finish() {
+	try {
+		if (m_upload()) m_upload.finish();
+		if (m_compute()) m_compute.finish();
+		if (m_download()) m_download.finish();
 
 	} catch(cl::Error& err) {
 		cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
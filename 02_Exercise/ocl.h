@@ -3,6 +3,7 @@
 #define CL_USE_DEPRECATED_OPENCL_2_0_APIS
 #define __CL_ENABLE_EXCEPTIONS
 #include "cl.hpp"
+#include "Profiler.h"
 
 // http://www.khronos.org/registry/cl/specs/opencl-cplusplus-1.2.pdf	// C++ manual
 // http://www.khronos.org/registry/cl/specs/opencl-1.2.pdf				// C manual
@@ -10,8 +11,67 @@
 // error numbers are defined in cl.h 
 //#include <CL/cl.h>
 
+#include <vector>
+#include "FreeImagePlus.h"
+
 struct OCLData {
 	cl::Context m_context;
 	cl::CommandQueue m_queue;
 	cl::Kernel m_kernel;
-};
\ No newline at end of file
+	OCLProfiler *m_profiler = nullptr;	// records the transfers and kernels if set
+	// device resources of processOCL: the images come from OCLMemoryPool, the filters are reallocated only when
+	// the filter size changes and uploaded again only when they differ from the ones in m_filters
+	cl::Sampler m_sampler;
+	cl::Buffer m_hFilter;
+	cl::Buffer m_vFilter;
+	int m_fSize = 0;
+	std::vector<int> m_filters;		// hFilter followed by vFilter
+};
+
+////////////////////////////////////////////////////////////////////////
+// Asynchronous edge detection of a sequence of images of the same shape: uploads, kernels and downloads run on
+// three in-order queues and are chained by events, so the upload of image n + 1, the kernel of image n and the
+// download of image n - 1 overlap. Depth pairs of device images are used round robin.
+class OCLPipeline {
+public:
+	static const int Depth = 3;
+
+private:
+	// device images of one image in flight and the events of their last use
+	struct Slot {
+		cl::Image2D m_source;
+		cl::Image2D m_dest;
+		cl::Event m_computed;		// kernel has read m_source
+		cl::Event m_downloaded;		// m_dest has been read back
+	};
+
+	OCLData& m_ocl;
+	cl::CommandQueue m_upload;
+	cl::CommandQueue m_compute;
+	cl::CommandQueue m_download;
+	cl::Sampler m_sampler;
+	cl::Buffer m_hFilter;
+	cl::Buffer m_vFilter;
+	int m_fSize;
+	std::vector<int> m_filters;		// hFilter followed by vFilter, for the native fallback
+	Slot m_slots[Depth];
+	int m_next = 0;
+	cl::ImageFormat m_format;
+	size_t m_width = 0;
+	size_t m_height = 0;
+	cl_uint m_maxValue = 0;
+
+public:
+	// uses context, device and kernel of ocl; the filters are uploaded once
+	OCLPipeline(OCLData& ocl, const int *hFilter, const int *vFilter, int fSize);
+	OCLPipeline(const OCLPipeline&) = delete;
+	OCLPipeline& operator=(const OCLPipeline&) = delete;
+	~OCLPipeline() { finish(); }
+
+	// enqueues the edge detection of input into output without waiting; input and output must not be changed or
+	// destroyed until the returned event has completed. A null event is returned by the native fallback, which is
+	// used without OpenCL device and on OpenCL errors and has completed the image when it returns.
+	cl::Event process(const fipImage& input, fipImage& output);
+	// waits for all images in flight
+	void finish();
+};
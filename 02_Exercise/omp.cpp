@@ -0,0 +1,319 @@
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <emmintrin.h>
+#include "main.h"
+#include "magnitude.h"
+#include "ImageView.h"
+
+////////////////////////////////////////////////////////////////////////
+bool parseBorderMode(const char* name, BorderMode& border) {
+	const BorderMode modes[] = { BorderMode::Skip, BorderMode::Clamp, BorderMode::Mirror, BorderMode::Wrap, BorderMode::Zero };
+
+	for(BorderMode mode: modes) {
+		if (strcmp(name, borderModeName(mode)) == 0) {
+			border = mode;
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////
+const char* borderModeName(BorderMode border) {
+	switch(border) {
+	case BorderMode::Skip: return "skip";
+	case BorderMode::Mirror: return "mirror";
+	case BorderMode::Wrap: return "wrap";
+	case BorderMode::Zero: return "zero";
+	default: return "clamp";
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// Supported pixel formats: T is the channel type, C the number of channels stored per pixel (see ImageView).
+// Filter responses are kept with C ints per pixel; the alpha lane of BGRA stays zero.
+// The channel loop is written out because not every compiler unrolls it at /O2.
+template<typename T, int C>
+static inline void accumulate(int *hC, int *vC, const T *iC, int hf, int vf) {
+	hC[0] += hf*iC[0];
+	vC[0] += vf*iC[0];
+	if (C >= 3) {
+		hC[1] += hf*iC[1];
+		hC[2] += hf*iC[2];
+		vC[1] += vf*iC[1];
+		vC[2] += vf*iC[2];
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// magnitude stage per format: BGRA uses the interleaved variant, all other formats are a flat sequence of channel values
+static void magnitudeRow(const int *hC, const int *vC, BYTE *out, int n, int channels, MagnitudeMode mag) {
+	if (channels == 4) {
+		magnitude(hC, vC, out, n, mag);
+	} else {
+		magnitudePlane(hC, vC, out, channels*n, mag);
+	}
+}
+
+static void magnitudeRow(const int *hC, const int *vC, unsigned short *out, int n, int channels, MagnitudeMode mag) {
+	magnitudePlane16(hC, vC, out, channels*n, mag);
+}
+
+////////////////////////////////////////////////////////////////////////
+// slow path: computes the filter responses of one pixel whose filter window exceeds the image
+template<typename T, int C>
+static void processBorderPixel(const ImageView<const T, C>& in, int *hC, int *vC, int u, int v, const int *hFilter, const int *vFilter, int fSize, BorderMode border) {
+	const int fSizeD2 = fSize/2;
+	int fi = 0;
+
+	for(int k = 0; k < C; k++) hC[k] = vC[k] = 0;
+	for(int j = 0; j < fSize; j++) {
+		const int y = borderIndex(v + j - fSizeD2, in.getHeight(), border);
+
+		for(int i = 0; i < fSize; i++) {
+			const int x = borderIndex(u + i - fSizeD2, in.getWidth(), border);
+
+			if (x >= 0 && y >= 0) accumulate<T, C>(hC, vC, in(x, y), hFilter[fi], vFilter[fi]);
+			fi++;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// 8 consecutive channel values widened to 16 bits
+static inline __m128i load8(const BYTE *p) {
+	return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128());
+}
+
+static inline __m128i load8(const unsigned short *p) {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+////////////////////////////////////////////////////////////////////////
+// adds the exact 32-bit products of 8 unsigned channel values and the 16-bit coefficient f to acc[0] and acc[1];
+// SSE2 has no 32-bit multiplication, hence the products are assembled from their low and high 16 bits
+template<typename T>
+static inline void multiplyAdd8(__m128i x, __m128i f, __m128i acc[2]) {
+	const __m128i lo = _mm_mullo_epi16(x, f);
+	__m128i hi = _mm_mulhi_epi16(x, f);
+
+	// mulhi treats x as signed: 16-bit values of 32768 and more are missing 65536*f
+	if (sizeof(T) == 2) hi = _mm_add_epi16(hi, _mm_and_si128(_mm_srai_epi16(x, 15), f));
+	acc[0] = _mm_add_epi32(acc[0], _mm_unpacklo_epi16(lo, hi));
+	acc[1] = _mm_add_epi32(acc[1], _mm_unpackhi_epi16(lo, hi));
+}
+
+////////////////////////////////////////////////////////////////////////
+// fast path of the formats without unused lanes (gray and BGR): a row is a flat sequence of channel values, and
+// channel value n of the filter responses only depends on the values n + C*i of the rows above and below;
+// 8 channel values at a time with exact 32-bit sums, the filter coefficients have to fit into a short
+template<typename T, int C>
+static void processInteriorRowSIMD(const ImageView<const T, C>& in, int *hRow, int *vRow, int v, int u0, int u1, const int *hFilter, const int *vFilter, int fSize) {
+	const int fSizeD2 = fSize/2;
+	const int n1 = C*u1;
+	int n = C*u0;
+
+	for(; n + 8 <= n1; n += 8) {
+		__m128i hAcc[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+		__m128i vAcc[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+		int fi = 0;
+
+		for(int j = 0; j < fSize; j++) {
+			const T *iC = in.rowPtr(v + j - fSizeD2) + n - C*fSizeD2;
+
+			for(int i = 0; i < fSize; i++) {
+				const __m128i x = load8(iC);
+
+				multiplyAdd8<T>(x, _mm_set1_epi16((short)hFilter[fi]), hAcc);
+				multiplyAdd8<T>(x, _mm_set1_epi16((short)vFilter[fi]), vAcc);
+				iC += C;
+				fi++;
+			}
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(hRow + n), hAcc[0]);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(hRow + n + 4), hAcc[1]);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(vRow + n), vAcc[0]);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(vRow + n + 4), vAcc[1]);
+	}
+
+	// remaining channel values
+	for(; n < n1; n++) {
+		int hC = 0, vC = 0, fi = 0;
+
+		for(int j = 0; j < fSize; j++) {
+			const T *iC = in.rowPtr(v + j - fSizeD2) + n - C*fSizeD2;
+
+			for(int i = 0; i < fSize; i++) {
+				hC += hFilter[fi]*iC[0];
+				vC += vFilter[fi]*iC[0];
+				iC += C;
+				fi++;
+			}
+		}
+		hRow[n] = hC;
+		vRow[n] = vC;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+static bool fitsShort(const int *filter, int fSize) {
+	return all_of(filter, filter + fSize*fSize, [](int f) { return f >= SHRT_MIN && f <= SHRT_MAX; });
+}
+
+////////////////////////////////////////////////////////////////////////
+// fast path: computes the filter responses of the pixels [u0,u1) of row v; the filter windows lie completely inside the image
+template<typename T, int C>
+static void processInteriorRow(const ImageView<const T, C>& in, int *hRow, int *vRow, int v, int u0, int u1, const int *hFilter, const int *vFilter, int fSize) {
+	if (C != 4 && fitsShort(hFilter, fSize) && fitsShort(vFilter, fSize)) {
+		processInteriorRowSIMD<T, C>(in, hRow, vRow, v, u0, u1, hFilter, vFilter, fSize);
+		return;
+	}
+
+	const int fSizeD2 = fSize/2;
+	typename ImageView<const T, C>::Window win = in.window(u0, v);
+
+	for(int u = u0; u < u1; u++) {
+		int hC[C] = {}, vC[C] = {};		// local sums: the compiler cannot keep sums in registers that may alias the image bytes
+		int fi = 0;
+
+		for(int j = 0; j < fSize; j++) {
+			const T *iC = win(-fSizeD2, j - fSizeD2);
+
+			for(int i = 0; i < fSize; i++) {
+				accumulate<T, C>(hC, vC, iC, hFilter[fi], vFilter[fi]);
+				iC += C;
+				fi++;
+			}
+		}
+		copy(hC, hC + C, hRow + C*u);
+		copy(vC, vC + C, vRow + C*u);
+		win.moveRight();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// pixels [x0,x1) of row v: interior pixels run the branch-free fast path, only the border strips of width fSize/2
+// take the slow path; the filter responses are collected first and then converted by the magnitude stage
+template<typename T, int C>
+static void processRow(const ImageView<const T, C>& in, const ImageView<T, C>& out, int *hRow, int *vRow, int v, int x0, int x1, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag) {
+	const int w = in.getWidth();
+	const int h = in.getHeight();
+	const int fSizeD2 = fSize/2;
+	const int left = min(max(fSizeD2, x0), x1);			// end of the left border strip
+	const int right = max(min(w - fSizeD2, x1), left);	// begin of the right border strip
+	T *oRow = out.rowPtr(v);
+
+	if (v >= fSizeD2 && v < h - fSizeD2) {
+		processInteriorRow<T, C>(in, hRow, vRow, v, left, right, hFilter, vFilter, fSize);
+		if (border == BorderMode::Skip) {
+			magnitudeRow(hRow + C*left, vRow + C*left, oRow + C*left, right - left, C, mag);
+		} else {
+			for(int u = x0; u < left; u++) processBorderPixel<T, C>(in, hRow + C*u, vRow + C*u, u, v, hFilter, vFilter, fSize, border);
+			for(int u = right; u < x1; u++) processBorderPixel<T, C>(in, hRow + C*u, vRow + C*u, u, v, hFilter, vFilter, fSize, border);
+			magnitudeRow(hRow + C*x0, vRow + C*x0, oRow + C*x0, x1 - x0, C, mag);
+		}
+	} else if (border != BorderMode::Skip) {
+		for(int u = x0; u < x1; u++) processBorderPixel<T, C>(in, hRow + C*u, vRow + C*u, u, v, hFilter, vFilter, fSize, border);
+		magnitudeRow(hRow + C*x0, vRow + C*x0, oRow + C*x0, x1 - x0, C, mag);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+template<typename T, int C>
+static void processFormat(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag) {
+	const ImageView<const T, C> in(input);
+	const ImageView<T, C> out(output);
+	const int w = in.getWidth();
+	const int h = in.getHeight();
+
+	#pragma omp parallel
+	{
+		vector<int> hRow(C*w), vRow(C*w);
+
+		#pragma omp for
+		for(int v = 0; v < h; v++) {
+			processRow<T, C>(in, out, hRow.data(), vRow.data(), v, 0, w, hFilter, vFilter, fSize, border, mag);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// regions are distributed dynamically because their sizes differ
+template<typename T, int C>
+static void processFormatRegions(const fipImage& input, fipImage& output, const vector<Region>& regions, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag) {
+	const ImageView<const T, C> in(input);
+	const ImageView<T, C> out(output);
+	const int w = in.getWidth();
+
+	#pragma omp parallel
+	{
+		vector<int> hRow(C*w), vRow(C*w);
+
+		#pragma omp for schedule(dynamic)
+		for(int r = 0; r < (int)regions.size(); r++) {
+			const Region& reg = regions[r];
+
+			for(int v = reg.m_y0; v < reg.m_y1; v++) {
+				processRow<T, C>(in, out, hRow.data(), vRow.data(), v, reg.m_x0, reg.m_x1, hFilter, vFilter, fSize, border, mag);
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+bool isSupportedFormat(const fipImage& image) {
+	const unsigned bpp = image.getBitsPerPixel();
+
+	switch(image.getImageType()) {
+	case FIT_BITMAP: return (bpp == 8 && image.isGrayscale()) || bpp == 24 || bpp == 32;
+	case FIT_UINT16: return true;
+	default: return false;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// edge detection on CPU with OpenMP for 8-bit gray, 16-bit gray, 24-bit BGR and 32-bit BGRA images;
+// the output has the format of the input
+void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag) {
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
+	assert(input.getImageType() == output.getImageType());
+	assert(isSupportedFormat(input));
+
+	if (input.getImageType() == FIT_UINT16) {
+		processFormat<unsigned short, 1>(input, output, hFilter, vFilter, fSize, border, mag);
+		return;
+	}
+	switch(input.getBitsPerPixel()) {
+	case 8: processFormat<BYTE, 1>(input, output, hFilter, vFilter, fSize, border, mag); break;
+	case 24: processFormat<BYTE, 3>(input, output, hFilter, vFilter, fSize, border, mag); break;
+	default: processFormat<BYTE, 4>(input, output, hFilter, vFilter, fSize, border, mag); break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// same as processParallel but restricted to the given non-overlapping regions; all other output pixels stay untouched
+void processRegions(const fipImage& input, fipImage& output, const vector<Region>& regions, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag) {
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
+	assert(input.getImageType() == output.getImageType());
+	assert(isSupportedFormat(input));
+
+	if (input.getImageType() == FIT_UINT16) {
+		processFormatRegions<unsigned short, 1>(input, output, regions, hFilter, vFilter, fSize, border, mag);
+		return;
+	}
+	switch(input.getBitsPerPixel()) {
+	case 8: processFormatRegions<BYTE, 1>(input, output, regions, hFilter, vFilter, fSize, border, mag); break;
+	case 24: processFormatRegions<BYTE, 3>(input, output, regions, hFilter, vFilter, fSize, border, mag); break;
+	default: processFormatRegions<BYTE, 4>(input, output, regions, hFilter, vFilter, fSize, border, mag); break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// filter responses of the pixels [u0,u1) of row v of a BGRA view, 4 ints per pixel as expected by magnitude();
+// the filter windows have to lie inside the view. Used by stages that need the gradients besides the magnitude.
+void processResponses(const ImageView<const BYTE, 4>& in, int *hRow, int *vRow, int v, int u0, int u1, const int *hFilter, const int *vFilter, int fSize) {
+	assert(v >= fSize/2 && v < in.getHeight() - fSize/2 && u0 >= fSize/2 && u1 <= in.getWidth() - fSize/2);
+	processInteriorRow<BYTE, 4>(in, hRow, vRow, v, u0, u1, hFilter, vFilter, fSize);
+}
@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <omp.h>
+#include "pipeline.h"
+#include "ImageView.h"
+
+void processResponses(const ImageView<const BYTE, 4>& in, int *hRow, int *vRow, int v, int u0, int u1, const int *hFilter, const int *vFilter, int fSize);
+
+////////////////////////////////////////////////////////////////////////
+// Gaussian blur with binomial weights (size 3 or 5)
+class BlurStage : public FilterStage {
+	int m_size;
+	int m_weights[5];
+	int m_norm;
+
+public:
+	BlurStage(int size) : m_size((size >= 5) ? 5 : 3) {
+		const int w3[] = { 1, 2, 1 };
+		const int w5[] = { 1, 4, 6, 4, 1 };
+		int sum = 0;
+
+		for(int i = 0; i < m_size; i++) {
+			m_weights[i] = (m_size == 3) ? w3[i] : w5[i];
+			sum += m_weights[i];
+		}
+		m_norm = sum*sum;
+	}
+	const char* getName() const override { return "blur"; }
+	int radius() const override { return m_size/2; }
+	void apply(const Tile& in, Tile& out, int x0, int y0, int x1, int y1) const override {
+		const int r = radius();
+
+		#pragma omp parallel for if(!omp_in_parallel())
+		for(int y = y0; y < y1; y++) {
+			for(int x = x0; x < x1; x++) {
+				int acc[3] = { 0, 0, 0 };
+
+				for(int j = 0; j < m_size; j++) {
+					const int *p = in.c(x - r, y + j - r);
+					for(int i = 0; i < m_size; i++) {
+						const int f = m_weights[j]*m_weights[i];
+						acc[0] += f*p[0];
+						acc[1] += f*p[1];
+						acc[2] += f*p[2];
+						p += 4;
+					}
+				}
+				int *q = out.c(x, y);
+				q[0] = (acc[0] + m_norm/2)/m_norm;
+				q[1] = (acc[1] + m_norm/2)/m_norm;
+				q[2] = (acc[2] + m_norm/2)/m_norm;
+				q[3] = 0;
+			}
+		}
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+// Horizontal and vertical gradient followed by the magnitude stage: runs the interior path of processParallel on the tile.
+// The quantized gradient direction of every channel is kept in the auxiliary lanes for non-maximum suppression:
+// 0 = horizontal gradient, 1 = diagonal (45 degrees), 2 = vertical gradient, 3 = anti-diagonal (135 degrees)
+class EdgeStage : public FilterStage {
+	vector<int> m_hFilter, m_vFilter;
+	int m_fSize;
+	MagnitudeMode m_mag;
+
+	static int direction(int gy, int gx) {
+		const int ax = abs(gx), ay = abs(gy);
+
+		if (100*ay <= 41*ax) return 0;		// tan(22.5) = 0.414
+		if (41*ay >= 100*ax) return 2;
+		return ((gx > 0) == (gy > 0)) ? 1 : 3;
+	}
+
+public:
+	EdgeStage(const int *hFilter, const int *vFilter, int fSize, MagnitudeMode mag)
+		: m_hFilter(hFilter, hFilter + fSize*fSize), m_vFilter(vFilter, vFilter + fSize*fSize), m_fSize(fSize), m_mag(mag) {}
+	const char* getName() const override { return "edges"; }
+	int radius() const override { return m_fSize/2; }
+	bool usesAux() const override { return true; }
+	void apply(const Tile& in, Tile& out, int x0, int y0, int x1, int y1) const override {
+		const int r = radius();
+		const int n = x1 - x0;
+		const int tw = n + 2*r;
+		const int th = y1 - y0 + 2*r;
+		vector<BYTE>& bits = out.m_scratch;		// the tiles of a thread share one buffer
+
+		if (bits.size() < (size_t)4*tw*th) bits.resize((size_t)4*tw*th);
+		const ImageView<const BYTE, 4> view(bits.data(), tw, th, 4*tw);
+
+		// the input rectangle as a BGRA view, so that the convolution engine of processParallel runs on the tile;
+		// the values of the previous stages are 8 bit already
+		#pragma omp parallel for if(!omp_in_parallel())
+		for(int y = 0; y < th; y++) {
+			const int *p = in.c(x0 - r, y0 - r + y);
+			BYTE *q = bits.data() + (size_t)4*tw*y;
+
+			for(int i = 0; i < 4*tw; i++) q[i] = (BYTE)min(max(p[i], 0), 255);
+		}
+
+		#pragma omp parallel if(!omp_in_parallel())
+		{
+			vector<int> hRow(4*tw), vRow(4*tw);
+			vector<BYTE> mRow(4*n);
+
+			#pragma omp for
+			for(int y = y0; y < y1; y++) {
+				processResponses(view, hRow.data(), vRow.data(), y - y0 + r, r, r + n, m_hFilter.data(), m_vFilter.data(), m_fSize);
+				magnitude(hRow.data() + 4*r, vRow.data() + 4*r, mRow.data(), n, m_mag);
+				for(int x = x0; x < x1; x++) {
+					const int k = 4*(x - x0);
+					const int *hC = hRow.data() + 4*r + k;
+					const int *vC = vRow.data() + 4*r + k;
+					int *q = out.c(x, y);
+					int *dir = out.d(x, y);
+
+					for(int l = 0; l < 3; l++) {
+						q[l] = mRow[k + l];
+						dir[l] = direction(hC[l], vC[l]);
+					}
+					q[3] = dir[3] = 0;
+				}
+			}
+		}
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+// Keeps only local maxima of the magnitude along the gradient direction
+class NonMaxStage : public FilterStage {
+public:
+	const char* getName() const override { return "non-max suppression"; }
+	int radius() const override { return 1; }
+	bool usesAux() const override { return true; }
+	void apply(const Tile& in, Tile& out, int x0, int y0, int x1, int y1) const override {
+		static const int dx[] = { 1, 1, 0, 1 };
+		static const int dy[] = { 0, 1, 1, -1 };
+
+		#pragma omp parallel for if(!omp_in_parallel())
+		for(int y = y0; y < y1; y++) {
+			for(int x = x0; x < x1; x++) {
+				const int *p = in.c(x, y);
+				const int *dir = in.d(x, y);
+				int *q = out.c(x, y);
+
+				for(int l = 0; l < 3; l++) {
+					const int k = dir[l];
+					const int m1 = in.c(x + dx[k], y + dy[k])[l];
+					const int m2 = in.c(x - dx[k], y - dy[k])[l];
+					q[l] = (p[l] >= m1 && p[l] >= m2) ? p[l] : 0;
+				}
+				q[3] = 0;
+				copy(dir, dir + 4, out.d(x, y));
+			}
+		}
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+class ThresholdStage : public FilterStage {
+	int m_threshold;
+
+public:
+	ThresholdStage(int t) : m_threshold(t) {}
+	const char* getName() const override { return "threshold"; }
+	void apply(const Tile& in, Tile& out, int x0, int y0, int x1, int y1) const override {
+		#pragma omp parallel for if(!omp_in_parallel())
+		for(int y = y0; y < y1; y++) {
+			for(int x = x0; x < x1; x++) {
+				const int *p = in.c(x, y);
+				int *q = out.c(x, y);
+
+				for(int l = 0; l < 3; l++) q[l] = (p[l] >= m_threshold) ? 255 : 0;
+				q[3] = 0;
+			}
+		}
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+FilterPipeline::FilterPipeline(BorderMode border) : m_border(border) {
+	// wrap would need intermediates from the opposite side of the image, skip has no defined intermediate borders
+	if (m_border == BorderMode::Wrap || m_border == BorderMode::Skip) m_border = BorderMode::Clamp;
+}
+
+////////////////////////////////////////////////////////////////////////
+FilterPipeline& FilterPipeline::blur(int size) {
+	m_stages.emplace_back(new BlurStage(size));
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+FilterPipeline& FilterPipeline::edges(const int *hFilter, const int *vFilter, int fSize, MagnitudeMode mag) {
+	m_stages.emplace_back(new EdgeStage(hFilter, vFilter, fSize, mag));
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+FilterPipeline& FilterPipeline::nonMaxSuppression() {
+	m_stages.emplace_back(new NonMaxStage());
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+FilterPipeline& FilterPipeline::threshold(int t) {
+	m_stages.emplace_back(new ThresholdStage(t));
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+int FilterPipeline::radius() const {
+	int r = 0;
+	for(const auto& s: m_stages) r += s->radius();
+	return r;
+}
+
+////////////////////////////////////////////////////////////////////////
+// runs all stages on the output rectangle [x0,x1)x[y0,y1); bufs are two ping-pong buffers
+void FilterPipeline::runTile(const fipImage& input, fipImage& output, int x0, int y0, int x1, int y1, Tile bufs[2]) const {
+	const ConstBGRAView in(input);
+	const BGRAView out(output);
+	const int w = in.getWidth();
+	const int h = in.getHeight();
+	int r = radius();
+	int cur = 0;
+
+	// load input region enlarged by the radius of the whole pipeline
+	Tile& first = bufs[cur];
+	first.setRegion(x0 - r, y0 - r, x1 - x0 + 2*r, y1 - y0 + 2*r);
+	for(int y = y0 - r; y < y1 + r; y++) {
+		const int sy = borderIndex(y, h, m_border);
+		for(int x = x0 - r; x < x1 + r; x++) {
+			const int sx = borderIndex(x, w, m_border);
+			int *q = first.c(x, y);
+
+			if (sx >= 0 && sy >= 0) {
+				const BYTE *p = in(sx, sy);
+				q[0] = p[0]; q[1] = p[1]; q[2] = p[2]; q[3] = 0;
+			} else {
+				q[0] = q[1] = q[2] = q[3] = 0;
+			}
+			fill(first.d(x, y), first.d(x, y) + 4, 0);
+		}
+	}
+
+	for(const auto& stage: m_stages) {
+		const Tile& src = bufs[cur];
+		Tile& dst = bufs[1 - cur];
+
+		r -= stage->radius();
+		dst.setRegion(x0 - r, y0 - r, x1 - x0 + 2*r, y1 - y0 + 2*r);
+
+		// compute the part inside the image
+		const int cx0 = max(dst.m_x0, 0), cx1 = min(dst.m_x0 + dst.m_w, w);
+		const int cy0 = max(dst.m_y0, 0), cy1 = min(dst.m_y0 + dst.m_h, h);
+		stage->apply(src, dst, cx0, cy0, cx1, cy1);
+
+		// fill the part outside the image according to the border mode
+		if (r > 0) {
+			for(int y = dst.m_y0; y < dst.m_y0 + dst.m_h; y++) {
+				const bool rowInside = y >= 0 && y < h;
+				const int sy = min(max(borderIndex(y, h, m_border), cy0), cy1 - 1);
+
+				for(int x = dst.m_x0; x < dst.m_x0 + dst.m_w; x++) {
+					if (rowInside && x >= 0 && x < w) {
+						x = w - 1;	// jump over the inside part
+						continue;
+					}
+					const int bx = borderIndex(x, w, m_border);
+					const int by = borderIndex(y, h, m_border);
+
+					if (bx < 0 || by < 0) {
+						fill(dst.c(x, y), dst.c(x, y) + 4, 0);
+						fill(dst.d(x, y), dst.d(x, y) + 4, 0);
+					} else {
+						const int sx = min(max(bx, cx0), cx1 - 1);
+						copy(dst.c(sx, sy), dst.c(sx, sy) + 4, dst.c(x, y));
+						copy(dst.d(sx, sy), dst.d(sx, sy) + 4, dst.d(x, y));
+					}
+				}
+			}
+		}
+		cur = 1 - cur;
+	}
+
+	// write output
+	const Tile& res = bufs[cur];
+	for(int y = y0; y < y1; y++) {
+		BYTE *oC = out(x0, y);
+		for(int x = x0; x < x1; x++) {
+			const int *p = res.c(x, y);
+			oC[0] = (BYTE)min(max(p[0], 0), 255);
+			oC[1] = (BYTE)min(max(p[1], 0), 255);
+			oC[2] = (BYTE)min(max(p[2], 0), 255);
+			oC[3] = 255;
+			oC += BGRAView::Channels;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// fused execution: every thread runs the whole pipeline on one tile after the other
+void FilterPipeline::run(const fipImage& input, fipImage& output, int tileW, int tileH) const {
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
+	assert(input.getBitsPerPixel() == 32);
+	const int w = input.getWidth();
+	const int h = input.getHeight();
+	const int nx = (w + tileW - 1)/tileW;
+	const int ny = (h + tileH - 1)/tileH;
+
+	#pragma omp parallel
+	{
+		Tile bufs[2];
+
+		#pragma omp for schedule(dynamic)
+		for(int t = 0; t < nx*ny; t++) {
+			const int x0 = (t%nx)*tileW;
+			const int y0 = (t/nx)*tileH;
+
+			runTile(input, output, x0, y0, min(x0 + tileW, w), min(y0 + tileH, h), bufs);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// one full-image pass per stage: every stage reads and writes full-size intermediates, parallelized inside the stage
+void FilterPipeline::runPasses(const fipImage& input, fipImage& output) const {
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
+	assert(input.getBitsPerPixel() == 32);
+	Tile bufs[2];
+
+	runTile(input, output, 0, 0, input.getWidth(), input.getHeight(), bufs);
+}
+
+////////////////////////////////////////////////////////////////////////
+size_t FilterPipeline::getFusedTraffic(int w, int h) const {
+	// input and output image once, intermediates stay in cache
+	return 2*sizeof(RGBQUAD)*(size_t)w*h;
+}
+
+////////////////////////////////////////////////////////////////////////
+size_t FilterPipeline::getPassesTraffic(int w, int h) const {
+	// input image, every stage reads and writes its intermediates, output image
+	const size_t pixels = (size_t)w*h;
+	size_t traffic = 2*sizeof(RGBQUAD)*pixels;
+	bool aux = false;
+
+	for(const auto& s: m_stages) {
+		const size_t lanes = s->usesAux() || aux ? 8 : 4;
+		traffic += 2*lanes*sizeof(int)*pixels;
+		aux = s->usesAux();
+	}
+	return traffic;
+}
+
+////////////////////////////////////////////////////////////////////////
+void FilterPipeline::print(ostream& os) const {
+	for(size_t i = 0; i < m_stages.size(); i++) {
+		if (i) os << " -> ";
+		os << m_stages[i]->getName();
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "main.h"
+#include "magnitude.h"
+
+////////////////////////////////////////////////////////////////////////
+// Rectangular part of an intermediate result in image coordinates; the region may exceed the image.
+// Each pixel holds 4 int lanes (blue, green, red, unused) in m_c and 4 int lanes of auxiliary data in m_d.
+// m_scratch is working memory of the stages writing the tile; it is kept across tiles like the lanes.
+struct Tile {
+	int m_x0 = 0, m_y0 = 0, m_w = 0, m_h = 0;
+	vector<int> m_c, m_d;
+	vector<BYTE> m_scratch;
+
+	void setRegion(int x0, int y0, int w, int h) {
+		m_x0 = x0; m_y0 = y0; m_w = w; m_h = h;
+		if (m_c.size() < (size_t)4*w*h) {
+			m_c.resize((size_t)4*w*h);
+			m_d.resize((size_t)4*w*h);
+		}
+	}
+	int* c(int x, int y) { return m_c.data() + 4*((size_t)(y - m_y0)*m_w + x - m_x0); }
+	const int* c(int x, int y) const { return m_c.data() + 4*((size_t)(y - m_y0)*m_w + x - m_x0); }
+	int* d(int x, int y) { return m_d.data() + 4*((size_t)(y - m_y0)*m_w + x - m_x0); }
+	const int* d(int x, int y) const { return m_d.data() + 4*((size_t)(y - m_y0)*m_w + x - m_x0); }
+};
+
+////////////////////////////////////////////////////////////////////////
+// One operation of a filter pipeline
+// apply computes the pixels [x0,x1)x[y0,y1) of out; in covers this rectangle enlarged by radius()
+class FilterStage {
+public:
+	virtual ~FilterStage() {}
+	virtual const char* getName() const = 0;
+	virtual int radius() const { return 0; }
+	virtual bool usesAux() const { return false; }	// reads or writes m_d
+	virtual void apply(const Tile& in, Tile& out, int x0, int y0, int x1, int y1) const = 0;
+};
+
+////////////////////////////////////////////////////////////////////////
+// Composition of filter stages
+// run() fuses all stages tile by tile so that intermediates stay in cache,
+// runPasses() executes every stage as a full-image pass (the traditional way) for comparison.
+// Both produce identical results: the border mode is applied to the input of every stage.
+class FilterPipeline {
+	vector<unique_ptr<FilterStage>> m_stages;
+	BorderMode m_border;
+
+	void runTile(const fipImage& input, fipImage& output, int x0, int y0, int x1, int y1, Tile bufs[2]) const;
+
+public:
+	FilterPipeline(BorderMode border = BorderMode::Clamp);
+
+	FilterPipeline& blur(int size);
+	FilterPipeline& edges(const int *hFilter, const int *vFilter, int fSize, MagnitudeMode mag);
+	FilterPipeline& nonMaxSuppression();
+	FilterPipeline& threshold(int t);
+
+	int radius() const;
+	void run(const fipImage& input, fipImage& output, int tileW = 64, int tileH = 32) const;
+	void runPasses(const fipImage& input, fipImage& output) const;
+
+	// estimated DRAM traffic in bytes
+	size_t getFusedTraffic(int w, int h) const;
+	size_t getPassesTraffic(int w, int h) const;
+	void print(ostream& os) const;
+};
@@ -0,0 +1,267 @@
+#include <cstring>
+#include <climits>
+#include <vector>
+#include <algorithm>
+#include <emmintrin.h>
+#include "planar.h"
+
+////////////////////////////////////////////////////////////////////////
+static size_t roundUp(size_t n, size_t m) {
+	return (n + m - 1)/m*m;
+}
+
+////////////////////////////////////////////////////////////////////////
+PlanarImage::~PlanarImage() {
+	for(BYTE *p: m_planes) _mm_free(p);
+}
+
+////////////////////////////////////////////////////////////////////////
+// row padding covers the unaligned 16-pixel loads of the convolution beyond the last column and the apron
+void PlanarImage::setSize(int width, int height) {
+	const int left = (int)roundUp(m_apron, Alignment);
+	const size_t stride = roundUp(left + roundUp(width, 16) + m_apron, Alignment);
+
+	if (width == m_width && height == m_height && stride == m_stride) return;
+	m_width = width;
+	m_height = height;
+	m_left = left;
+	m_stride = stride;
+	for(BYTE*& p: m_planes) {
+		const size_t size = (height + 2*m_apron)*m_stride;
+
+		_mm_free(p);
+		p = static_cast<BYTE*>(_mm_malloc(size, Alignment));
+		memset(p, 0, size);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+void PlanarImage::fillBorder(BorderMode border) {
+	const int a = m_apron;
+	if (a == 0) return;
+
+	// skip mode has no defined border, clamp keeps the padding reads defined
+	if (border == BorderMode::Skip) border = BorderMode::Clamp;
+
+	#pragma omp parallel for
+	for(int y = -a; y < m_height + a; y++) {
+		const int sy = borderIndex(y, m_height, border);
+
+		for(int c = 0; c < 3; c++) {
+			BYTE *row = getRow(c, y);
+
+			if (sy < 0) {
+				memset(row - a, 0, m_width + 2*a);
+				continue;
+			}
+			if (sy != y) memcpy(row, getRow(c, sy), m_width);
+			for(int x = -a; x < 0; x++) {
+				const int sx = borderIndex(x, m_width, border);
+				row[x] = (sx < 0) ? 0 : row[sx];
+			}
+			for(int x = m_width; x < m_width + a; x++) {
+				const int sx = borderIndex(x, m_width, border);
+				row[x] = (sx < 0) ? 0 : row[sx];
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// 16 pixels per iteration: the channels are masked out of the 32-bit lanes and packed to bytes
+void PlanarImage::deinterleave(const fipImage& image, BorderMode border) {
+	assert(image.getBitsPerPixel() == 32);
+	const int w = image.getWidth();
+	const int h = image.getHeight();
+	const __m128i mask = _mm_set1_epi32(0xFF);
+
+	setSize(w, h);
+
+	#pragma omp parallel for
+	for(int y = 0; y < h; y++) {
+		const BYTE *src = image.getScanLine(y);
+		BYTE *b = getRow(0, y);
+		BYTE *g = getRow(1, y);
+		BYTE *r = getRow(2, y);
+		int x = 0;
+
+		for(; x + 16 <= w; x += 16) {
+			const __m128i *s = reinterpret_cast<const __m128i*>(src + 4*x);
+			const __m128i p0 = _mm_loadu_si128(s + 0);
+			const __m128i p1 = _mm_loadu_si128(s + 1);
+			const __m128i p2 = _mm_loadu_si128(s + 2);
+			const __m128i p3 = _mm_loadu_si128(s + 3);
+			__m128i c[3];
+
+			for(int k = 0; k < 3; k++) {
+				const __m128i c0 = _mm_and_si128(_mm_srli_epi32(p0, 8*k), mask);
+				const __m128i c1 = _mm_and_si128(_mm_srli_epi32(p1, 8*k), mask);
+				const __m128i c2 = _mm_and_si128(_mm_srli_epi32(p2, 8*k), mask);
+				const __m128i c3 = _mm_and_si128(_mm_srli_epi32(p3, 8*k), mask);
+				c[k] = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+			}
+			_mm_store_si128(reinterpret_cast<__m128i*>(b + x), c[0]);
+			_mm_store_si128(reinterpret_cast<__m128i*>(g + x), c[1]);
+			_mm_store_si128(reinterpret_cast<__m128i*>(r + x), c[2]);
+		}
+		for(; x < w; x++) {
+			b[x] = src[4*x];
+			g[x] = src[4*x + 1];
+			r[x] = src[4*x + 2];
+		}
+	}
+	fillBorder(border);
+}
+
+////////////////////////////////////////////////////////////////////////
+// 16 pixels per iteration: blue/green and red/alpha are interleaved to 16-bit pairs and then to 32-bit pixels
+void PlanarImage::interleave(fipImage& image) const {
+	assert(image.getBitsPerPixel() == 32 && (int)image.getWidth() == m_width && (int)image.getHeight() == m_height);
+	const __m128i alpha = _mm_set1_epi8((char)0xFF);
+
+	#pragma omp parallel for
+	for(int y = 0; y < m_height; y++) {
+		BYTE *dst = image.getScanLine(y);
+		const BYTE *b = getRow(0, y);
+		const BYTE *g = getRow(1, y);
+		const BYTE *r = getRow(2, y);
+		int x = 0;
+
+		for(; x + 16 <= m_width; x += 16) {
+			const __m128i vb = _mm_load_si128(reinterpret_cast<const __m128i*>(b + x));
+			const __m128i vg = _mm_load_si128(reinterpret_cast<const __m128i*>(g + x));
+			const __m128i vr = _mm_load_si128(reinterpret_cast<const __m128i*>(r + x));
+			const __m128i bgLo = _mm_unpacklo_epi8(vb, vg);
+			const __m128i bgHi = _mm_unpackhi_epi8(vb, vg);
+			const __m128i raLo = _mm_unpacklo_epi8(vr, alpha);
+			const __m128i raHi = _mm_unpackhi_epi8(vr, alpha);
+			__m128i *d = reinterpret_cast<__m128i*>(dst + 4*x);
+
+			_mm_storeu_si128(d + 0, _mm_unpacklo_epi16(bgLo, raLo));
+			_mm_storeu_si128(d + 1, _mm_unpackhi_epi16(bgLo, raLo));
+			_mm_storeu_si128(d + 2, _mm_unpacklo_epi16(bgHi, raHi));
+			_mm_storeu_si128(d + 3, _mm_unpackhi_epi16(bgHi, raHi));
+		}
+		for(; x < m_width; x++) {
+			dst[4*x] = b[x];
+			dst[4*x + 1] = g[x];
+			dst[4*x + 2] = r[x];
+			dst[4*x + 3] = 255;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// filter responses of 16 consecutive pixels of one plane: 16-bit products and sums,
+// exact as long as 255 times the sum of the absolute filter coefficients fits into a short
+static inline void convolve16(const BYTE *center, size_t stride, const short *hFilter, const short *vFilter, int fSize, int *hRow, int *vRow) {
+	const int fSizeD2 = fSize/2;
+	const __m128i zero = _mm_setzero_si128();
+	__m128i hLo = zero, hHi = zero, vLo = zero, vHi = zero;
+	const BYTE *p = center - fSizeD2*stride - fSizeD2;
+	int fi = 0;
+
+	for(int j = 0; j < fSize; j++) {
+		for(int i = 0; i < fSize; i++) {
+			const __m128i pix = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			const __m128i lo = _mm_unpacklo_epi8(pix, zero);
+			const __m128i hi = _mm_unpackhi_epi8(pix, zero);
+			const __m128i hf = _mm_set1_epi16(hFilter[fi]);
+			const __m128i vf = _mm_set1_epi16(vFilter[fi]);
+
+			hLo = _mm_add_epi16(hLo, _mm_mullo_epi16(lo, hf));
+			hHi = _mm_add_epi16(hHi, _mm_mullo_epi16(hi, hf));
+			vLo = _mm_add_epi16(vLo, _mm_mullo_epi16(lo, vf));
+			vHi = _mm_add_epi16(vHi, _mm_mullo_epi16(hi, vf));
+			fi++;
+		}
+		p += stride;
+	}
+
+	// sign extension to 32 bits
+	__m128i *h = reinterpret_cast<__m128i*>(hRow);
+	__m128i *v = reinterpret_cast<__m128i*>(vRow);
+	_mm_storeu_si128(h + 0, _mm_srai_epi32(_mm_unpacklo_epi16(zero, hLo), 16));
+	_mm_storeu_si128(h + 1, _mm_srai_epi32(_mm_unpackhi_epi16(zero, hLo), 16));
+	_mm_storeu_si128(h + 2, _mm_srai_epi32(_mm_unpacklo_epi16(zero, hHi), 16));
+	_mm_storeu_si128(h + 3, _mm_srai_epi32(_mm_unpackhi_epi16(zero, hHi), 16));
+	_mm_storeu_si128(v + 0, _mm_srai_epi32(_mm_unpacklo_epi16(zero, vLo), 16));
+	_mm_storeu_si128(v + 1, _mm_srai_epi32(_mm_unpackhi_epi16(zero, vLo), 16));
+	_mm_storeu_si128(v + 2, _mm_srai_epi32(_mm_unpacklo_epi16(zero, vHi), 16));
+	_mm_storeu_si128(v + 3, _mm_srai_epi32(_mm_unpackhi_epi16(zero, vHi), 16));
+}
+
+////////////////////////////////////////////////////////////////////////
+// scalar filter responses of one pixel of one plane, used if the 16-bit sums could overflow
+static inline void convolve1(const BYTE *center, size_t stride, const int *hFilter, const int *vFilter, int fSize, int *hC, int *vC) {
+	const int fSizeD2 = fSize/2;
+	const BYTE *p = center - fSizeD2*stride - fSizeD2;
+	int fi = 0;
+
+	*hC = *vC = 0;
+	for(int j = 0; j < fSize; j++) {
+		for(int i = 0; i < fSize; i++) {
+			*hC += hFilter[fi]*p[i];
+			*vC += vFilter[fi]*p[i];
+			fi++;
+		}
+		p += stride;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// edge detection on planes with OpenMP: every plane row is convolved 16 pixels at a time
+void processPlanar(const PlanarImage& input, PlanarImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag) {
+	assert(input.getApron() >= fSize/2);
+	const int w = input.getWidth();
+	const int h = input.getHeight();
+	const int wp = (int)roundUp(w, 16);
+	const int fSizeD2 = fSize/2;
+	const size_t stride = input.getStride();
+	vector<short> hFilter16(fSize*fSize), vFilter16(fSize*fSize);
+	int hSum = 0, vSum = 0;
+
+	for(int i = 0; i < fSize*fSize; i++) {
+		hFilter16[i] = (short)hFilter[i];
+		vFilter16[i] = (short)vFilter[i];
+		hSum += abs(hFilter[i]);
+		vSum += abs(vFilter[i]);
+	}
+	const bool simd = 255*max(hSum, vSum) <= SHRT_MAX;
+
+	output.setSize(w, h);
+
+	#pragma omp parallel
+	{
+		vector<int> hRow(wp), vRow(wp);
+
+		#pragma omp for
+		for(int y = 0; y < h; y++) {
+			for(int c = 0; c < 3; c++) {
+				const BYTE *iRow = input.getRow(c, y);
+				BYTE *oRow = output.getRow(c, y);
+
+				if (simd) {
+					for(int x = 0; x < wp; x += 16) {
+						convolve16(iRow + x, stride, hFilter16.data(), vFilter16.data(), fSize, hRow.data() + x, vRow.data() + x);
+					}
+				} else {
+					for(int x = 0; x < w; x++) {
+						convolve1(iRow + x, stride, hFilter, vFilter, fSize, hRow.data() + x, vRow.data() + x);
+					}
+				}
+				magnitudePlane(hRow.data(), vRow.data(), oRow, w, mag);
+
+				// skip mode keeps the input pixels at the border
+				if (border == BorderMode::Skip) {
+					if (y < fSizeD2 || y >= h - fSizeD2) {
+						memcpy(oRow, iRow, w);
+					} else {
+						for(int x = 0; x < min(fSizeD2, w); x++) oRow[x] = iRow[x];
+						for(int x = max(w - fSizeD2, 0); x < w; x++) oRow[x] = iRow[x];
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "main.h"
+#include "magnitude.h"
+
+////////////////////////////////////////////////////////////////////////
+// Planar (structure of arrays) image with separate blue, green and red planes.
+// Every row starts on a 64-byte boundary and is padded to a multiple of 64 bytes;
+// an apron of getApron() pixels around the image holds the border pixels of the convolution.
+// Rows are numbered like fipImage scanlines.
+class PlanarImage {
+	int m_width = 0;
+	int m_height = 0;
+	int m_apron;
+	int m_left = 0;					// offset of column 0 within a row, multiple of 64
+	size_t m_stride = 0;			// bytes per row
+	BYTE *m_planes[3] = { nullptr, nullptr, nullptr };
+
+public:
+	static const int Alignment = 64;
+
+	PlanarImage(int apron = 0) : m_apron(apron) {}
+	PlanarImage(const PlanarImage&) = delete;
+	PlanarImage& operator=(const PlanarImage&) = delete;
+	~PlanarImage();
+
+	int getWidth() const { return m_width; }
+	int getHeight() const { return m_height; }
+	int getApron() const { return m_apron; }
+	size_t getStride() const { return m_stride; }
+	BYTE* getRow(int c, int y) { return m_planes[c] + (y + m_apron)*m_stride + m_left; }
+	const BYTE* getRow(int c, int y) const { return m_planes[c] + (y + m_apron)*m_stride + m_left; }
+
+	void setSize(int width, int height);
+	void fillBorder(BorderMode border);
+
+	// SIMD converters from and to 32-bit fipImages; deinterleave resizes this image and fills the apron
+	void deinterleave(const fipImage& image, BorderMode border);
+	void interleave(fipImage& image) const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// Edge detection on planes: output must have the size of input, input needs an apron of at least fSize/2
+void processPlanar(const PlanarImage& input, PlanarImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag);
@@ -0,0 +1,266 @@
+#include <cstring>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "stream.h"
+
+void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag);
+
+////////////////////////////////////////////////////////////////////////
+static bool hasExtension(const char* fileName, const char* ext) {
+	const char* dot = strrchr(fileName, '.');
+	if (!dot) return false;
+
+	string e(dot + 1);
+	transform(e.begin(), e.end(), e.begin(), [](unsigned char c) { return (char)tolower(c); });	// negative chars are undefined for tolower
+	return e == ext;
+}
+
+////////////////////////////////////////////////////////////////////////
+// fopen without the deprecation warning of MSVC; null if the file cannot be opened
+static FILE* openFile(const char* fileName, const char* mode) {
+#ifdef _MSC_VER
+	FILE *file = nullptr;
+	return (fopen_s(&file, fileName, mode) == 0) ? file : nullptr;
+#else
+	return fopen(fileName, mode);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////
+// Binary PPM/PGM reader
+class PNMReader : public ScanlineReader {
+	FILE *m_file;
+	int m_channels;
+	vector<BYTE> m_buffer;
+
+	// reads the next header token and skips comments
+	bool readValue(int& value) {
+		int c = fgetc(m_file);
+		while(c != EOF && (isspace(c) || c == '#')) {
+			if (c == '#') while(c != EOF && c != '\n') c = fgetc(m_file);
+			c = fgetc(m_file);
+		}
+		value = 0;
+		if (!isdigit(c)) return false;
+		while(isdigit(c)) {
+			value = 10*value + c - '0';
+			c = fgetc(m_file);
+		}
+		return true;	// the single white space after the value has been consumed
+	}
+
+public:
+	PNMReader(const char* fileName) : m_file(openFile(fileName, "rb")), m_channels(0) {
+		int maxVal;
+
+		if (m_file && fgetc(m_file) == 'P') {
+			const int type = fgetc(m_file);
+			m_channels = (type == '6') ? 3 : (type == '5') ? 1 : 0;
+			if (m_channels && readValue(m_width) && readValue(m_height) && readValue(maxVal) && maxVal < 256) {
+				m_buffer.resize(m_width*m_channels);
+				return;
+			}
+		}
+		m_width = m_height = 0;
+	}
+	~PNMReader() {
+		if (m_file) fclose(m_file);
+	}
+	bool readRow(BYTE *row) override {
+		if (!m_file || fread(m_buffer.data(), m_channels, m_width, m_file) != (size_t)m_width) return false;
+
+		const BYTE *p = m_buffer.data();
+		for(int u = 0; u < m_width; u++) {
+			if (m_channels == 3) {
+				row[0] = p[2]; row[1] = p[1]; row[2] = p[0];
+			} else {
+				row[0] = row[1] = row[2] = p[0];
+			}
+			row[3] = 255;
+			p += m_channels;
+			row += 4;
+		}
+		return true;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+// Binary PPM writer
+class PPMWriter : public ScanlineWriter {
+	FILE *m_file;
+	int m_width;
+	vector<BYTE> m_buffer;
+
+public:
+	PPMWriter(const char* fileName, int width, int height) : m_file(openFile(fileName, "wb")), m_width(width), m_buffer(3*width) {
+		if (m_file) fprintf(m_file, "P6\n%d %d\n255\n", width, height);
+	}
+	~PPMWriter() {
+		close();
+	}
+	bool writeRow(const BYTE *row) override {
+		BYTE *p = m_buffer.data();
+		for(int u = 0; u < m_width; u++) {
+			p[0] = row[2]; p[1] = row[1]; p[2] = row[0];
+			p += 3;
+			row += 4;
+		}
+		return m_file && fwrite(m_buffer.data(), 3, m_width, m_file) == (size_t)m_width;
+	}
+	bool close() override {
+		bool ok = true;
+		if (m_file) {
+			ok = fclose(m_file) == 0;
+			m_file = nullptr;
+		}
+		return ok;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+// Fallback for formats without scanline access: holds the whole image in memory
+class FreeImageReader : public ScanlineReader {
+	fipImage m_image;
+	int m_row = 0;
+
+public:
+	FreeImageReader(const char* fileName) {
+		if (m_image.load(fileName) && m_image.convertTo32Bits()) {
+			m_width = m_image.getWidth();
+			m_height = m_image.getHeight();
+		}
+	}
+	bool readRow(BYTE *row) override {
+		if (m_row >= m_height) return false;
+		memcpy(row, m_image.getScanLine(m_height - 1 - m_row++), 4*m_width);	// FreeImage stores the bottom row first
+		return true;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+class FreeImageWriter : public ScanlineWriter {
+	fipImage m_image;
+	string m_fileName;
+	int m_row = 0;
+
+public:
+	FreeImageWriter(const char* fileName, int width, int height) : m_image(FIT_BITMAP, width, height, 32), m_fileName(fileName) {}
+	~FreeImageWriter() {
+		close();
+	}
+	bool writeRow(const BYTE *row) override {
+		if (m_row >= (int)m_image.getHeight()) return false;
+		memcpy(m_image.getScanLine(m_image.getHeight() - 1 - m_row++), row, 4*m_image.getWidth());
+		return true;
+	}
+	bool close() override {
+		if (m_fileName.empty()) return true;
+
+		const bool ok = m_image.save(m_fileName.c_str()) != FALSE;
+		m_fileName.clear();
+		return ok;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////
+unique_ptr<ScanlineReader> openScanlineReader(const char* fileName) {
+	if (hasExtension(fileName, "ppm") || hasExtension(fileName, "pgm")) {
+		return unique_ptr<ScanlineReader>(new PNMReader(fileName));
+	} else {
+		cout << "Warning: " << fileName << " is decoded completely, memory is not bounded" << endl;
+		return unique_ptr<ScanlineReader>(new FreeImageReader(fileName));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+unique_ptr<ScanlineWriter> openScanlineWriter(const char* fileName, int width, int height) {
+	if (hasExtension(fileName, "ppm")) {
+		return unique_ptr<ScanlineWriter>(new PPMWriter(fileName, width, height));
+	} else {
+		cout << "Warning: " << fileName << " is encoded completely, memory is not bounded" << endl;
+		return unique_ptr<ScanlineWriter>(new FreeImageWriter(fileName, width, height));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// Bands are stored in fipImages; FreeImage stores the bottom row first, hence logical band row k (counted from the top)
+// is scanline height - 1 - k. This keeps the filter orientation identical to processing the whole image at once.
+static BYTE* bandRow(const fipImage& band, int k) {
+	return band.getScanLine(band.getHeight() - 1 - k);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Peak memory is two bands of width x (bandRows + fSize - 1) pixels independent of the image height
+bool processStream(ScanlineReader& reader, ScanlineWriter& writer, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag, int bandRows) {
+	const int w = reader.getWidth();
+	const int h = reader.getHeight();
+	const int fSizeD2 = fSize/2;
+	const int overlap = fSize - 1;
+
+	if (w == 0 || h == 0) return false;
+	if (border == BorderMode::Wrap) {
+		// the bottom rows would be needed before the first band can be processed
+		cerr << "Wrap border mode is not available for streaming, clamp is used instead" << endl;
+		border = BorderMode::Clamp;
+	}
+	bandRows = max(bandRows, fSize);
+
+	fipImage in(FIT_BITMAP, w, bandRows + overlap, 32);
+	fipImage out(FIT_BITMAP, w, bandRows + overlap, 32);
+	const size_t rowSize = 4*w;
+	int next = 0;	// next image row delivered by the reader
+
+	for(int r0 = 0; r0 < h; ) {
+		const int n = min(bandRows, h - r0);	// number of output rows of this band
+		const int first = r0 - fSizeD2;			// image row of logical band row 0
+
+		if (n + overlap < (int)in.getHeight()) {
+			// last band is shorter: keep the overlapping rows
+			fipImage last(FIT_BITMAP, w, n + overlap, 32);
+			for(int k = 0; k < overlap; k++) memcpy(bandRow(last, k), bandRow(in, k), rowSize);
+			in = last;
+			out.setSize(FIT_BITMAP, w, n + overlap, 32);
+		}
+		const int bandH = in.getHeight();
+
+		// read new rows
+		for(int k = 0; k < bandH; k++) {
+			const int r = first + k;
+			if (r >= next && r < h) {
+				if (!reader.readRow(bandRow(in, k))) return false;
+				next++;
+			}
+		}
+
+		// rows outside of the image
+		for(int k = 0; k < bandH; k++) {
+			const int r = first + k;
+			if (r < 0 || r >= h) {
+				const int y = borderIndex(r, h, (border == BorderMode::Skip) ? BorderMode::Clamp : border);
+				if (y < 0) {
+					memset(bandRow(in, k), 0, rowSize);
+				} else {
+					memcpy(bandRow(in, k), bandRow(in, y - first), rowSize);
+				}
+			}
+		}
+
+		// convolve band in parallel
+		if (border == BorderMode::Skip) memcpy(out.getScanLine(0), in.getScanLine(0), in.getImageSize());
+		processParallel(in, out, hFilter, vFilter, fSize, border, mag);
+
+		// write output rows
+		for(int k = fSizeD2; k < fSizeD2 + n; k++) {
+			const int r = first + k;
+			const bool skipped = border == BorderMode::Skip && (r < fSizeD2 || r >= h - fSizeD2);
+			if (!writer.writeRow(bandRow(skipped ? in : out, k))) return false;
+		}
+
+		// move the overlapping rows to the top of the band
+		for(int k = 0; k < overlap; k++) memcpy(bandRow(in, k), bandRow(in, bandH - overlap + k), rowSize);
+		r0 += n;
+	}
+	return writer.close();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <cstdio>
+#include "main.h"
+#include "magnitude.h"
+
+////////////////////////////////////////////////////////////////////////
+// Source of 32-bit BGRA scanlines in top-down order
+class ScanlineReader {
+protected:
+	int m_width = 0;
+	int m_height = 0;
+
+public:
+	virtual ~ScanlineReader() {}
+	int getWidth() const { return m_width; }
+	int getHeight() const { return m_height; }
+	virtual bool readRow(BYTE *row) = 0;
+};
+
+////////////////////////////////////////////////////////////////////////
+// Sink of 32-bit BGRA scanlines in top-down order
+class ScanlineWriter {
+public:
+	virtual ~ScanlineWriter() {}
+	virtual bool writeRow(const BYTE *row) = 0;
+	virtual bool close() { return true; }
+};
+
+////////////////////////////////////////////////////////////////////////
+// Binary PPM (P6) and PGM (P5) files are read and written scanline by scanline,
+// all other formats go through FreeImage and therefore need the whole image in memory
+unique_ptr<ScanlineReader> openScanlineReader(const char* fileName);
+unique_ptr<ScanlineWriter> openScanlineWriter(const char* fileName, int width, int height);
+
+////////////////////////////////////////////////////////////////////////
+// Edge detection with bounded memory: the image is processed in bands of bandRows rows with fSize - 1 overlapping rows
+bool processStream(ScanlineReader& reader, ScanlineWriter& writer, const int *hFilter, const int *vFilter, int fSize, BorderMode border, MagnitudeMode mag, int bandRows);
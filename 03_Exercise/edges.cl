@@ -7,8 +7,9 @@ uint dist(int x, int y) {
 ////////////////////////////////////////////////////////////////////////
 // OpenCL kernel
 __kernel void edges(__read_only image2d_t source, __write_only image2d_t dest, __constant int* hFilter, __constant int* vFilter, int fSize, sampler_t sampler) {
-	const int w = get_global_size(0);
-	const int h = get_global_size(1);
+	// the global range may be padded to multiples of the work-group size
+	const int w = get_image_width(dest);
+	const int h = get_image_height(dest);
 	const int col = get_global_id(0);
 	const int row = get_global_id(1);
 	const int fSizeD2 = fSize/2;
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <thread>
+#include "Stopwatch.h"
+#include "hetero.h"
+
+////////////////////////////////////////////////////////////////////////
+// prototypes
+void processParallelRows(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, int y0, int y1);
+void processOCLRows(OCLData& ocl, const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, int y0, int y1);
+
+////////////////////////////////////////////////////////////////////////
+void HeteroEdges::addDevice(OCLData& ocl, const string& name) {
+	m_backends.push_back({ name, &ocl, 0 });
+	for(Backend& b: m_backends) b.m_share = 1.0/m_backends.size();
+}
+
+////////////////////////////////////////////////////////////////////////
+void HeteroEdges::addOpenMP() {
+	m_backends.push_back({ "OpenMP", nullptr, 0 });
+	for(Backend& b: m_backends) b.m_share = 1.0/m_backends.size();
+}
+
+////////////////////////////////////////////////////////////////////////
+// shares proportional to the smoothed throughputs
+void HeteroEdges::rebalance() {
+	double sum = 0;
+
+	for(const Backend& b: m_backends) sum += b.m_rowsPerMs;
+	if (sum <= 0) return;
+	for(Backend& b: m_backends) b.m_share = b.m_rowsPerMs/sum;
+}
+
+////////////////////////////////////////////////////////////////////////
+void HeteroEdges::process(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize) {
+	const int n = (int)m_backends.size();
+	const int h = input.getHeight();
+	if (n == 0) return;
+
+	// band heights: MinRows per backend, the remaining rows by share with cumulative rounding
+	const int minRows = (h >= n*MinRows) ? MinRows : h/n;
+	const int rest = h - n*minRows;
+	vector<int> y(n + 1, 0);
+	double cumShare = 0;
+
+	for(int i = 0; i < n; i++) {
+		cumShare += m_backends[i].m_share;
+		y[i + 1] = (i == n - 1) ? h : (i + 1)*minRows + (int)(cumShare*rest + 0.5);
+	}
+
+	// each device is driven by its own host thread, the OpenMP band is processed by the calling thread
+	vector<thread> threads;
+	auto run = [&](int i) {
+		Backend& b = m_backends[i];
+		Stopwatch sw;
+
+		b.m_rows = y[i + 1] - y[i];
+		if (b.m_rows == 0) return;
+		sw.Start();
+		if (b.m_ocl) {
+			processOCLRows(*b.m_ocl, input, output, hFilter, vFilter, fSize, y[i], y[i + 1]);
+		} else {
+			processParallelRows(input, output, hFilter, vFilter, fSize, y[i], y[i + 1]);
+		}
+		sw.Stop();
+		b.m_time = sw.GetElapsedTimeMilliseconds();
+	};
+
+	for(int i = 0; i < n; i++) {
+		if (m_backends[i].m_ocl) threads.emplace_back(run, i);
+	}
+	for(int i = 0; i < n; i++) {
+		if (!m_backends[i].m_ocl) run(i);
+	}
+	for(thread& t: threads) t.join();
+
+	// update the throughputs with exponential smoothing
+	for(Backend& b: m_backends) {
+		if (b.m_rows == 0) continue;
+		const double rowsPerMs = b.m_rows/max(b.m_time, 1e-3);
+		b.m_rowsPerMs = (b.m_rowsPerMs == 0) ? rowsPerMs : m_smoothing*rowsPerMs + (1 - m_smoothing)*b.m_rowsPerMs;
+	}
+	rebalance();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "main.h"
+#include "ocl.h"
+
+////////////////////////////////////////////////////////////////////////
+// Co-execution of the edge detection on several OpenCL devices and the OpenMP path: the image is split into
+// horizontal bands, one per backend, which are processed concurrently. The band heights follow the throughput
+// measured on the previous frames, hence all backends tend to finish at the same time.
+class HeteroEdges {
+public:
+	struct Backend {
+		string m_name;
+		OCLData *m_ocl;				// nullptr: OpenMP
+		double m_share;				// fraction of the rows in the next frame
+		double m_rowsPerMs = 0;		// smoothed throughput, 0 before the first frame
+		int m_rows = 0;				// rows of the last frame
+		double m_time = 0;			// ms of the last frame
+	};
+
+private:
+	std::vector<Backend> m_backends;
+	double m_smoothing;				// weight of the last frame in the throughput
+
+	void rebalance();
+
+public:
+	static const int MinRows = 16;	// every backend gets some rows to keep its throughput up to date
+
+	HeteroEdges(double smoothing = 0.5) : m_smoothing(smoothing) {}
+
+	// the device must have been initialized with the edges kernel
+	void addDevice(OCLData& ocl, const string& name);
+	void addOpenMP();
+
+	void process(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize);
+
+	const std::vector<Backend>& getBackends() const { return m_backends; }
+};
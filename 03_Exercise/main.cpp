@@ -1,9 +1,19 @@
+#include <algorithm>
 #include "Stopwatch.h"
 #include "main.h"
 #include "ocl.h"
+#include "ImageView.h"
+#include "Kernel.h"
+#include "ImageBuffer.h"
+#include "ImageIO.h"
+#include "ImageCompare.h"
+#include "hetero.h"
+#include "Runtime.h"
+#include "MemoryPool.h"
 
 ////////////////////////////////////////////////////////////////////////
 // prototypes
+OCLData initOCL(OCLDevice& dev, const char* kernelFileName, const char* kernelName);
 OCLData initOCL(const char* kernelFileName, const char* kernelName, const bool useCPU);
 void processOCL(OCLData& ocl, const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize);
 
@@ -14,67 +24,85 @@ static BYTE dist(int x, int y) {
 }
 
 ////////////////////////////////////////////////////////////////////////
-static void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize) {
+// processes the output rows [y0, y1) but not the border of fSize/2 pixels
+void processParallelRows(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, int y0, int y1) {
 	const int bypp = 4;
-	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getImageSize() == output.getImageSize());
+	assert(input.getWidth() == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
 	assert(input.getBitsPerPixel() == bypp*8);
 
-	const size_t stride = input.getScanWidth();
+	const ConstBGRAView in(input);
+	const BGRAView out(output);
 	const int fSizeD2 = fSize/2;
+	const int v0 = max(y0, fSizeD2);
+	const int v1 = min(y1, out.getHeight() - fSizeD2);
 
 	#pragma omp parallel for
-	for(int v = fSizeD2; v < (int)output.getHeight() - fSizeD2; v++) {
-		BYTE *iCenter = input.getScanLine(v) + bypp*fSizeD2;
-		BYTE *oPos = output.getScanLine(v) + bypp*fSizeD2;
+	for(int v = v0; v < v1; v++) {
+		ConstBGRAView::Window win = in.window(fSizeD2, v);
+		BYTE *oC = out(fSizeD2, v);
 
-		for(size_t u = fSizeD2; u < output.getWidth() - fSizeD2; u++) {
+		for(int u = fSizeD2; u < out.getWidth() - fSizeD2; u++) {
 			int hC[3] = { 0, 0, 0 };
 			int vC[3] = { 0, 0, 0 };
 			int fi = 0;
-			BYTE *iPos = iCenter - fSizeD2*stride - bypp*fSizeD2;
 
 			for(int j = 0; j < fSize; j++) {
+				const BYTE *iC = win(-fSizeD2, j - fSizeD2);
+
 				for(int i = 0; i < fSize; i++) {
-					const RGBQUAD *iC = reinterpret_cast<RGBQUAD*>(iPos);
 					int f = hFilter[fi];
 
-					hC[0] += f*iC->rgbBlue;
-					hC[1] += f*iC->rgbGreen;
-					hC[2] += f*iC->rgbRed;
+					hC[0] += f*iC[0];
+					hC[1] += f*iC[1];
+					hC[2] += f*iC[2];
 					f = vFilter[fi];
-					vC[0] += f*iC->rgbBlue;
-					vC[1] += f*iC->rgbGreen;
-					vC[2] += f*iC->rgbRed;
-					iPos += bypp;
+					vC[0] += f*iC[0];
+					vC[1] += f*iC[1];
+					vC[2] += f*iC[2];
+					iC += ConstBGRAView::Channels;
 					fi++;
 				}
-				iPos += stride - bypp*fSize;
 			}
-			RGBQUAD *oC = reinterpret_cast<RGBQUAD*>(oPos);
-			oC->rgbBlue = dist(hC[0], vC[0]);
-			oC->rgbGreen = dist(hC[1], vC[1]);
-			oC->rgbRed = dist(hC[2], vC[2]);
-			oC->rgbReserved = 255;
-			iCenter += bypp;
-			oPos += bypp;
+			oC[0] = dist(hC[0], vC[0]);
+			oC[1] = dist(hC[1], vC[1]);
+			oC[2] = dist(hC[2], vC[2]);
+			oC[3] = 255;
+			win.moveRight();
+			oC += BGRAView::Channels;
 		}
 	}
 }
 
 ////////////////////////////////////////////////////////////////////////
-static bool equals(const fipImage& im1, const fipImage& im2, int fSize) {
-	assert(im1.getWidth() == im2.getWidth() && im1.getHeight() == im2.getHeight() && im1.getImageSize() == im2.getImageSize());
-	assert(im1.getBitsPerPixel() == 32);
-	const int fSizeD2 = fSize/2;
+static void processParallel(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize) {
+	processParallelRows(input, output, hFilter, vFilter, fSize, 0, input.getHeight());
+}
 
-	for(unsigned int i = fSizeD2; i < im1.getHeight() - fSizeD2; i++) {
-		COLORREF *row1 = reinterpret_cast<COLORREF*>(im1.getScanLine(i));
-		COLORREF *row2 = reinterpret_cast<COLORREF*>(im2.getScanLine(i));
-		for(unsigned int j = fSizeD2; j < im1.getWidth() - fSizeD2; j++) {
-			if (row1[j] != row2[j]) return false;
-		}
+////////////////////////////////////////////////////////////////////////
+// compares the results of two backends but ignores the border of fSize/2 pixels; if they differ,
+// a heatmap of the differences is saved as diff<n>.png
+static bool verify(const char* label, const fipImage& im1, const fipImage& im2, int fSize) {
+	static int heatmaps = 0;
+	const ImageDiff diff = compareImages(im1, im2, fSize/2, Tolerance);
+
+	cout << label << ": " << diff << endl;
+	if (!diff.isEqual()) {
+		const string fileName = "diff" + to_string(++heatmaps) + ".png";
+		fipImage heatmap;
+
+		compareImages(im1, im2, fSize/2, Tolerance, &heatmap);
+		if (saveImage(heatmap, fileName.c_str())) cout << "heatmap of the differences: " << fileName << endl;
 	}
-	return true;
+	return diff.isEqual();
+}
+
+////////////////////////////////////////////////////////////////////////
+// output image from the pool: the CPU backends leave the border of fSize/2 pixels untouched, hence it has to hold the input pixels
+static shared_ptr<fipImage> createOutput(ImagePool& pool, const fipImage& input, int fSize) {
+	shared_ptr<fipImage> output = pool.acquire(input);
+
+	copyBorder(input, *output, fSize/2);
+	return output;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -84,140 +112,31 @@ int main(int argc, const char* argv[]) {
 		return -1;
 	}
 	int fSize = atoi(argv[1]);
-	if (fSize < 3 || fSize > 11 || (fSize & 1) == 0) {
-		cerr << "Wrong filter size. Filter size must be odd and between 3 and 9" << endl;
+	if (fSize < 3 || (fSize & 1) == 0) {
+		cerr << "Wrong filter size. Filter size must be odd and at least 3" << endl;
 		return -2;
 	}
 
+	MappedImage mapping;
 	fipImage image;
 
-	// load image
-	if (!image.load(argv[2])) {
+	// load image: raw images (.rimg) are mapped instead of decoded
+	if (!loadImage(argv[2], image, mapping)) {
 		cerr << "Image not found: " << argv[2] << endl;
 		return -3;
 	}
 
-	const int hFilter3[] = {
-		1, 1, 1,
-		0, 0, 0,
-	   -1,-1,-1,
-	};
-	const int vFilter3[] = {
-		1, 0,-1,
-		1, 0,-1,
-		1, 0,-1,
-	};
-	const int hFilter5[] = {
-		0, 0, 0, 0, 0,
-		1, 1, 1, 1, 1,
-		0, 0, 0, 0, 0,
-	   -1,-1,-1,-1,-1,
-	    0, 0, 0, 0, 0,
-	};
-	const int vFilter5[] = {
-		0, 1, 0,-1, 0,
-		0, 1, 0,-1, 0,
-		0, 1, 0,-1, 0,
-		0, 1, 0,-1, 0,
-		0, 1, 0,-1, 0,
-	};
-	const int hFilter7[] = {
-		0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1, 1, 1, 1,
-		0, 0, 0, 0, 0, 0, 0,
-	   -1,-1,-1,-1,-1,-1,-1,
-	    0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0,
-	};
-	const int vFilter7[] = {
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-		0, 0, 1, 0,-1, 0, 0,
-	};
-	const int hFilter9[] = {
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1, 1, 1, 1, 1, 1,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-	   -1,-1,-1,-1,-1,-1,-1,-1,-1,
-	    0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0,
-	};
-	const int vFilter9[] = {
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-		0, 0, 0, 1, 0,-1, 0, 0, 0,
-	};
-	const int hFilter11[] = {
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-	    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-	};
-	const int vFilter11[] = {
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0,-1, 0, 0, 0, 0,
-	};
-
 	Stopwatch sw;
 	double parTime;
-	const int *hFilter;
-	const int *vFilter;
-
-	switch(fSize) {
-	case 3:
-		hFilter = hFilter3;
-		vFilter = vFilter3;
-		break;
-	case 5:
-		hFilter = hFilter5;
-		vFilter = vFilter5;
-		break;
-	case 7:
-		hFilter = hFilter7;
-		vFilter = vFilter7;
-		break;
-	case 9:
-		hFilter = hFilter9;
-		vFilter = vFilter9;
-		break;
-	case 11:
-		hFilter = hFilter11;
-		vFilter = vFilter11;
-		break;
-	}
+	// hFilter: +1 in the row above and -1 in the row below the center, vFilter: its transposition
+	const Kernel hKernel = Kernel::prewitt(fSize), vKernel = hKernel.transposed();
+	const int *hFilter = hKernel.data();
+	const int *vFilter = vKernel.data();
 
-	// create output images
-	fipImage out1(image), out2(image), out3(image), out4(image);
+	// create output images: aligned pool buffers instead of copies of the input
+	ImagePool pool;
+	shared_ptr<fipImage> outputs[] = { createOutput(pool, image, fSize), createOutput(pool, image, fSize), createOutput(pool, image, fSize), createOutput(pool, image, fSize) };
+	fipImage &out1 = *outputs[0], &out2 = *outputs[1], &out3 = *outputs[2], &out4 = *outputs[3];
 
 	cout << "Edge detection with filter size " << fSize << endl << endl;
 
@@ -231,27 +150,66 @@ int main(int argc, const char* argv[]) {
 	
 	// process image on GPU with OpenCL and produce out2
 	OCLData ocl = initOCL("edges.cl", "edges", false);
+	OCLProfiler profiler;
+	ocl.m_profiler = &profiler;
 	cout << endl << "Start OpenCL on GPU" << endl;
 	sw.Start();
 	processOCL(ocl, image, out2, hFilter, vFilter, fSize);
 	sw.Stop();
 	cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime/sw.GetElapsedTimeMilliseconds() << endl;
+	profiler.print(cout, sw.GetElapsedTimeMilliseconds());
 
 	// compare out1 with out2
-	cout << boolalpha << "OpenMP and OpenCL on GPU produce the same results: " << equals(out1, out2, fSize) << endl << endl;
+	verify("OpenMP and OpenCL on GPU", out1, out2, fSize);
+	cout << endl;
+
+	// page-aligned copy of the input: a CPU device can use it in place like the pool outputs
+	shared_ptr<fipImage> aligned = pool.acquire(image);
+	copyPixels(image, *aligned);
 
 	OCLData oclCPU = initOCL("edges.cl", "edges", true);
-	cout << endl << "Start OpenCL on CPU" << endl;
+	profiler.clear();
+	oclCPU.m_profiler = &profiler;
+	cout << endl << "Start OpenCL on CPU" << (oclCPU.m_unifiedMemory ? " (zero-copy)" : "") << endl;
 	sw.Start();
-	processOCL(oclCPU, image, out3, hFilter, vFilter, fSize);
+	processOCL(oclCPU, *aligned, out3, hFilter, vFilter, fSize);
 	sw.Stop();
 	cout << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime / sw.GetElapsedTimeMilliseconds() << endl;
+	profiler.print(cout, sw.GetElapsedTimeMilliseconds());
 
 	// compare out1 with out3
-	cout << boolalpha << "OpenMP and OpenCL on CPU produce the same results: " << equals(out1, out3, fSize) << endl << endl;
+	verify("OpenMP and OpenCL on CPU", out1, out3, fSize);
+	cout << endl;
+
+	// co-execution: one band per OpenCL device and one for OpenMP, the band heights adapt from frame to frame
+	const int Frames = 8;
+	const vector<OCLDevice*> devices = OCLRuntime::get().all();
+	vector<OCLData> oclAll(devices.size());
+	HeteroEdges hetero;
+
+	for(size_t i = 0; i < devices.size(); i++) {
+		oclAll[i] = initOCL(*devices[i], "edges.cl", "edges");
+		if (oclAll[i].m_kernel()) hetero.addDevice(oclAll[i], "OpenCL on " + devices[i]->m_name);
+	}
+	hetero.addOpenMP();
+
+	cout << "Start co-execution" << endl;
+	for(int frame = 1; frame <= Frames; frame++) {
+		sw.Start();
+		hetero.process(*aligned, out4, hFilter, vFilter, fSize);
+		sw.Stop();
+		cout << "frame " << frame << ": " << sw.GetElapsedTimeMilliseconds() << " ms, speedup = " << parTime/sw.GetElapsedTimeMilliseconds() << ", rows:";
+		for(const HeteroEdges::Backend& b: hetero.getBackends()) cout << " " << b.m_name << " " << b.m_rows << " (" << b.m_time << " ms)";
+		cout << endl;
+	}
+
+	// compare out1 with out4
+	verify("OpenMP and co-execution", out1, out4, fSize);
+	OCLMemoryPool::get().print(cout);
+	cout << endl;
 
 	// save output image
-	if (!out3.save(argv[3])) {
+	if (!saveImage(out3, argv[3])) {
 		cerr << "Image not saved: " << argv[3] << endl;
 		return -1;
 	}
@@ -8,6 +8,13 @@ using namespace std;
 
 //#define FAST_MATH
 
+// channel tolerance when comparing results of backends with approximate square roots
+#ifdef FAST_MATH
+const int Tolerance = 1;
+#else
+const int Tolerance = 0;
+#endif
+
 #ifndef WIN32
 typedef unsigned long COLORREF;
 #endif
\ No newline at end of file
@@ -1,110 +1,65 @@
-#include <fstream>
 #include <string>
 #include <vector>
-#include <utility>
+#include <algorithm>
 #include "main.h"
 #include "ocl.h"
+#include "Runtime.h"
+#include "WorkGroupTuner.h"
+#include "MemoryPool.h"
+#include "ImageBuffer.h"
 
 ////////////////////////////////////////////////////////////////////////
-OCLData initOCL(const char* kernelFileName, const char* kernelName, const bool useCPU) {
-	OCLData ocl;
-	vector<cl::Platform> platforms;
-	vector<cl::Device> devices;
-
-	cout << "**************************************************************************" << endl;
-	try {
-		// discover all available platforms
-		cl::Platform::get(&platforms);
-		if (platforms.empty()) {
-			cerr << "Error: no OpenCL platform available" << endl;
-			return ocl;
-		}
+// prototypes
+void processParallelRows(const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, int y0, int y1);
 
-		string name, profile, version;
-		
-		for(cl::Platform& p: platforms) {
-			p.getInfo(CL_PLATFORM_NAME, &name);
-			p.getInfo(CL_PLATFORM_PROFILE, &profile);
-			p.getInfo(CL_PLATFORM_VERSION, &version);
-
-			vector<cl::Device> devs;
-
-			try {
-				if (useCPU) {
-					// get CPUs of this platform
-					p.getDevices(CL_DEVICE_TYPE_CPU, &devs);
-				} else {
-					// get GPUs of this platform
-					p.getDevices(CL_DEVICE_TYPE_GPU, &devs);
-				}
-
-			} catch(cl::Error&) {
-				// there is no GPU on this platform
-			}
-
-			if (!devs.empty()) {
-				// show platform
-				cout << "Platform " << name << " (" << version << ", " << profile << ")" << endl;
-
-				// discover all available GPUs on this platform
-				for(cl::Device& dev: devs) {
-					// get and show device information
-					dev.getInfo(CL_DEVICE_NAME, &name);
-					cl_uint maxComputeUnits;		dev.getInfo(CL_DEVICE_MAX_COMPUTE_UNITS, &maxComputeUnits);
-					cl_uint maxDims;				dev.getInfo(CL_DEVICE_MAX_WORK_ITEM_DIMENSIONS, &maxDims);
-					vector<size_t> workitemSize;	dev.getInfo(CL_DEVICE_MAX_WORK_ITEM_SIZES, &workitemSize);
-					size_t workgroupSize;			dev.getInfo(CL_DEVICE_MAX_WORK_GROUP_SIZE, &workgroupSize); // product of all dimensions
-					cl_ulong localMemSize;			dev.getInfo(CL_DEVICE_LOCAL_MEM_SIZE, &localMemSize);
-					cout << name << endl;
-					cout << "Max. Compute Units: " << maxComputeUnits << ", Max. Dimensions: " << maxDims << " [" << workitemSize[0] << "," << workitemSize[1] << "," << workitemSize[2] << "]" << endl;
-					cout << "Max. Work Group Size: " << workgroupSize << ", Max. Local Mem Size: " << localMemSize << endl << endl;
-				}
-
-				if (devices.empty()) {
-					// create s_context and command s_queue for the first GPU
-					cl::Device& dev = devs.front();
-					cl_context_properties cps[] = { CL_CONTEXT_PLATFORM, (cl_context_properties)(p)(), 0 };
-
-					ocl.m_context = cl::Context(CL_DEVICE_TYPE_GPU, cps);
-					ocl.m_queue = cl::CommandQueue(ocl.m_context, dev);
-
-					// add first device
-					devices.push_back(dev);
-				}
-			}
-		}
+////////////////////////////////////////////////////////////////////////
+OCLData initOCL(OCLDevice& dev, const char* kernelFileName, const char* kernelName) {
+	OCLData ocl;
 
-		// read source file
-		ifstream file(kernelFileName);
-		if (!file.good()) {
-			perror("Error");
-			return ocl;
-		}
-		string prog(istreambuf_iterator<char>(file), (istreambuf_iterator<char>()));	// read in file and store it in string prog
-		file.close();
-		cl::Program::Sources progSource(1, make_pair(prog.c_str(), prog.length() + 1));	// create source code object
+	ocl.m_context = dev.m_context;
+	ocl.m_queue = dev.m_queue;
+	ocl.m_kernel = OCLRuntime::get().getKernel(dev, kernelFileName, kernelName);
+	// CPUs and integrated GPUs share the host memory: processOCL then works on the images in place
+	ocl.m_unifiedMemory = dev.m_unifiedMemory;
+	return ocl;
+}
 
-		// compile and execute s_kernel code
-		cl::Program program(ocl.m_context, progSource);									// create program object
-		program.build(devices);															// build the program for given devices
-		ocl.m_kernel = cl::Kernel(program, kernelName);									// create the s_kernel: must be the name of the s_kernel in the cl file
+////////////////////////////////////////////////////////////////////////
+// fastest GPU or CPU of the runtime; without such a device or kernel the OCLData stays empty and processOCL
+// runs the OpenMP implementation
+OCLData initOCL(const char* kernelFileName, const char* kernelName, const bool useCPU) {
+	OCLDevice *dev = OCLRuntime::get().fastest(useCPU ? CL_DEVICE_TYPE_CPU : CL_DEVICE_TYPE_GPU);
+	OCLData ocl;
 
-	} catch(cl::Error& err) {
-		cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
-	}
-	cout << "**************************************************************************" << endl;
+	if (dev) ocl = initOCL(*dev, kernelFileName, kernelName);
+	printBackend(cout, kernelName, ocl.m_kernel() ? dev : nullptr, "OpenMP");
 	return ocl;
 }
 
 ////////////////////////////////////////////////////////////////////////
-void processOCL(OCLData& ocl, const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize) {
+// Only the rows [y0, y1) and an apron of fSize/2 rows on both sides (clamped to the image) are transferred.
+// The kernel processes the apron rows too, but they are not read back. The pooled device images have the height
+// of the whole image, so that all bands of a device share them whatever their height; the rows outside the
+// transferred ones are neither read for the result rows nor read back.
+void processOCLRows(OCLData& ocl, const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize, int y0, int y1) {
 	const int bypp = 4;
 	const size_t w = input.getWidth();
-	const size_t h = input.getHeight();
-	assert(w == output.getWidth() && h == output.getHeight() && input.getImageSize() == output.getImageSize());
+	assert(w == output.getWidth() && input.getHeight() == output.getHeight() && input.getBitsPerPixel() == output.getBitsPerPixel());
 	assert(input.getBitsPerPixel() == bypp*8);
+	assert(0 <= y0 && y0 < y1 && y1 <= (int)input.getHeight());
+	const int a0 = max(y0 - fSize/2, 0);
+	const int a1 = min(y1 + fSize/2, (int)input.getHeight());
+	const size_t h = a1 - a0;
 	const size_t stride = input.getScanWidth();
+	const size_t oStride = output.getScanWidth();
+	BYTE *in = input.getScanLine(a0);
 	const int fSize2 = fSize*fSize;
+
+	// native fallback
+	if (!ocl.m_kernel()) {
+		processParallelRows(input, output, hFilter, vFilter, fSize, y0, y1);
+		return;
+	}
 	
 	cl::size_t<3> origin;
 	cl::size_t<3> region; 
@@ -112,43 +67,102 @@ void processOCL(OCLData& ocl, const fipImage& input, fipImage& output, const int
 	region[1] = h; 
 	region[2] = 1;
 
+	// rows of the result within the band
+	cl::size_t<3> resultOrigin;
+	cl::size_t<3> resultRegion;
+	resultOrigin[1] = y0 - a0;
+	resultRegion[0] = w;
+	resultRegion[1] = y1 - y0;
+	resultRegion[2] = 1;
+
 	try {
 		// the image format describes the properties of each pixel
 		cl::ImageFormat format;
 		format.image_channel_order = CL_BGRA;
 		format.image_channel_data_type = CL_UNSIGNED_INT8;
 
-		// create sampler object
-		cl::Sampler sampler(ocl.m_context, CL_FALSE, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST); // on CPU must be not CL_ADDRESS_NONE
+		// create sampler object once
+		if (!ocl.m_sampler()) ocl.m_sampler = cl::Sampler(ocl.m_context, CL_FALSE, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST); // on CPU must be not CL_ADDRESS_NONE
 
-		// create space for the images
-		cl::Image2D source(ocl.m_context, CL_MEM_READ_ONLY, format, region[0], region[1], 0);
-		cl::Image2D dest (ocl.m_context, CL_MEM_WRITE_ONLY, format, region[0], region[1], 0);
+		// create space for the filters if the filter size has changed
+		if (!ocl.m_hFilter() || fSize != ocl.m_fSize) {
+			ocl.m_hFilter = cl::Buffer(ocl.m_context, CL_MEM_READ_ONLY, fSize2*sizeof(int));
+			ocl.m_vFilter = cl::Buffer(ocl.m_context, CL_MEM_READ_ONLY, fSize2*sizeof(int));
+			ocl.m_fSize = fSize;
+			ocl.m_filters.clear();
+		}
 
-		// create space for the filters
-		cl::Buffer hor(ocl.m_context, CL_MEM_READ_ONLY, fSize2*sizeof(int));
-		cl::Buffer ver(ocl.m_context, CL_MEM_READ_ONLY, fSize2*sizeof(int));
+		// write the filters to the device if they have changed
+		if (ocl.m_filters.empty() || !equal(hFilter, hFilter + fSize2, ocl.m_filters.begin()) || !equal(vFilter, vFilter + fSize2, ocl.m_filters.begin() + fSize2)) {
+			ocl.m_filters.assign(hFilter, hFilter + fSize2);
+			ocl.m_filters.insert(ocl.m_filters.end(), vFilter, vFilter + fSize2);
+			ocl.m_queue.enqueueWriteBuffer(ocl.m_hFilter, CL_TRUE, 0, fSize2*sizeof(int), hFilter);
+			ocl.m_queue.enqueueWriteBuffer(ocl.m_vFilter, CL_TRUE, 0, fSize2*sizeof(int), vFilter);
+		}
 
-		// write buffers to device
-		ocl.m_queue.enqueueWriteImage(source, CL_TRUE, origin, region, stride, 0, input.getScanLine(0));
-		ocl.m_queue.enqueueWriteBuffer(hor, CL_TRUE, 0, fSize2*sizeof(int), hFilter);
-		ocl.m_queue.enqueueWriteBuffer(ver, CL_TRUE, 0, fSize2*sizeof(int), vFilter);
+		// zero-copy: on devices sharing the host memory the images are used in place if they are page-aligned;
+		// not for bands with an apron, because the kernel would overwrite the apron rows of the neighbouring bands
+		const bool zeroCopy = ocl.m_unifiedMemory && a0 == y0 && a1 == y1 && isPageAligned(input) && isPageAligned(output);
+		cl::Image2D source, dest;
+		shared_ptr<cl::Image2D> pooledSource, pooledDest;
+		cl::NDRange offset;
+		cl::Event event;
+
+		if (zeroCopy) {
+			// the wrappers are cheap, but the host pointers may change from call to call
+			source = cl::Image2D(ocl.m_context, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, format, region[0], region[1], stride, in);
+			dest = cl::Image2D(ocl.m_context, CL_MEM_WRITE_ONLY | CL_MEM_USE_HOST_PTR, format, region[0], region[1], oStride, output.getScanLine(y0));
+		} else {
+			// full-height images of the pool: they return to it at the end of the call, all commands are blocking;
+			// the band keeps its image coordinates, hence clamping at the top and bottom of the image is unchanged
+			pooledSource = OCLMemoryPool::get().acquireImage(ocl.m_context, CL_MEM_READ_ONLY, format, w, input.getHeight());
+			pooledDest = OCLMemoryPool::get().acquireImage(ocl.m_context, CL_MEM_WRITE_ONLY, format, w, input.getHeight());
+			source = *pooledSource;
+			dest = *pooledDest;
+			origin[1] = a0;
+			resultOrigin[1] = y0;
+			offset = cl::NDRange(0, a0);
+
+			// write the band to the device
+			ocl.m_queue.enqueueWriteImage(source, CL_TRUE, origin, region, stride, 0, in, nullptr, &event);
+			profile(ocl.m_profiler, event, "write image", OCLProfiler::Upload, stride*h);
+		}
 
 		// set the s_kernel arguments
 		ocl.m_kernel.setArg(0, source);
 		ocl.m_kernel.setArg(1, dest);
-		ocl.m_kernel.setArg(2, hor);
-		ocl.m_kernel.setArg(3, ver);
+		ocl.m_kernel.setArg(2, ocl.m_hFilter);
+		ocl.m_kernel.setArg(3, ocl.m_vFilter);
 		ocl.m_kernel.setArg(4, fSize);
-		ocl.m_kernel.setArg(5, sampler);
-
-		// run the kernels
-		ocl.m_queue.enqueueNDRangeKernel(ocl.m_kernel, cl::NullRange, cl::NDRange(region[0], region[1]), cl::NullRange);
-
-		// read the output buffer back to the host
-		ocl.m_queue.enqueueReadImage(dest, CL_TRUE, origin, region, stride, 0, output.getScanLine(0));
+		ocl.m_kernel.setArg(5, ocl.m_sampler);
+
+		// run the kernels with the tuned work-group size
+		WorkGroupTuner::get().enqueue(ocl.m_queue, ocl.m_kernel, offset, region[0], region[1], nullptr, &event);
+		profile(ocl.m_profiler, event, "edges", OCLProfiler::Kernel);
+
+		if (zeroCopy) {
+			// mapping synchronizes the output with the host memory; no pixels are copied
+			size_t pitch;
+			void *p = ocl.m_queue.enqueueMapImage(dest, CL_TRUE, CL_MAP_READ, origin, region, &pitch, nullptr, nullptr, &event);
+			profile(ocl.m_profiler, event, "map image", OCLProfiler::Download);
+			assert(p == output.getScanLine(y0) && pitch == oStride);
+			ocl.m_queue.enqueueUnmapMemObject(dest, p);
+			ocl.m_queue.finish();
+		} else {
+			// read the output buffer back to the host
+			ocl.m_queue.enqueueReadImage(dest, CL_TRUE, resultOrigin, resultRegion, oStride, 0, output.getScanLine(y0), nullptr, &event);
+			profile(ocl.m_profiler, event, "read image", OCLProfiler::Download, oStride*resultRegion[1]);
+		}
 
 	} catch(cl::Error& err) {
-		cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
+		// the rows are computed by the native implementation; the filters on the device may be incomplete
+		cerr << "OpenCL error: " << err.what() << "(" << err.err() << "), switched to OpenMP" << endl;
+		ocl.m_filters.clear();
+		processParallelRows(input, output, hFilter, vFilter, fSize, y0, y1);
 	}
 }
+
+////////////////////////////////////////////////////////////////////////
+void processOCL(OCLData& ocl, const fipImage& input, fipImage& output, const int *hFilter, const int *vFilter, int fSize) {
+	processOCLRows(ocl, input, output, hFilter, vFilter, fSize, 0, input.getHeight());
+}
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <cassert>
+#include <vector>
 #include "FreeImagePlus.h"
 #include <cvmarkersobj.h>
 
@@ -9,6 +10,7 @@
 #define CL_USE_DEPRECATED_OPENCL_2_0_APIS
 #define __CL_ENABLE_EXCEPTIONS
 #include "cl.hpp"
+#include "Profiler.h"
 
 using namespace std;
 using namespace Concurrency::diagnostic;
@@ -23,10 +25,13 @@ struct OCLData {
 	cl::Context m_context;
 	cl::CommandQueue m_queue;
 	cl::Kernel m_kernel;
+	OCLProfiler *m_profiler = nullptr;	// records the transfers and kernels if set
+	bool m_unifiedMemory = false;	// device shares the host memory (CL_DEVICE_HOST_UNIFIED_MEMORY)
+	// device resources of processOCL: the images of the copy path come from OCLMemoryPool, the filters are
+	// reallocated only when the filter size changes and uploaded again only when they differ from the ones in m_filters
+	cl::Sampler m_sampler;
+	cl::Buffer m_hFilter;
+	cl::Buffer m_vFilter;
+	int m_fSize = 0;
+	vector<int> m_filters;		// hFilter followed by vFilter
 };
-
-struct OCLDataCPU : public OCLData {
-	cl::Context m_contextC;
-	cl::CommandQueue m_queueC;
-	cl::Kernel m_kernelC;
-};
\ No newline at end of file
@@ -1,9 +1,12 @@
 #include <iostream>
 #include <cmath>
 #include <climits>
+#include <cstdlib>
 #include <omp.h>
 #include "Stopwatch.h"
 #include "ocl.h"
+#include "MemoryPool.h"
+#include "Runtime.h"
 
 using namespace std;
 
@@ -25,6 +28,8 @@ int main() {
 	Stopwatch swBase, swCPU, swGPU;
 	int wrongCPUresults = 0, wrongGPUresults = 0;
 	OCLData ocl = initOCL("matrixmult.cl", "matrixmult");
+	OCLProfiler profiler;
+	ocl.m_profiler = &profiler;
 
 	for (int n = 1000; n <= 2000; n += 200) {
 		const int n2 = n*n;
@@ -52,7 +57,11 @@ int main() {
 		if (different(c0, c1, n2) && !wrongCPUresults) wrongCPUresults = n;
 		memset(c1, 0, n2*sizeof(int));
 
-		// run GPU matrix multiplication
+		// run GPU matrix multiplication: an untimed first run tunes the work-group size and fills the memory pool
+		ocl.m_profiler = nullptr;
+		matMultGPU(ocl, a, b, c1, n);
+		ocl.m_profiler = &profiler;
+		memset(c1, 0, n2*sizeof(int));
 		swGPU.Restart();
 		matMultGPU(ocl, a, b, c1, n);
 		swGPU.Stop();
@@ -81,4 +90,10 @@ int main() {
 		const double speedup = seqTime/gpuTime;
 		cout << "GPU results are valid, wall-clock time = " << gpuTime << " ms, S = " << speedup << ", E = " << speedup/ocl.m_computeUnits << endl;
 	}
+
+	// GPU time per stage of all matrix sizes
+	profiler.print(cout, swGPU.GetElapsedTimeMilliseconds());
+	OCLMemoryPool::get().print(cout);
+	string trace;
+	if (getEnvironment("OCL_TRACE", trace) && profiler.saveTrace(trace.c_str())) cout << "trace saved to " << trace << endl;
 }
\ No newline at end of file
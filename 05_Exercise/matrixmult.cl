@@ -1,17 +1,17 @@
 ///////////////////////////////////////////////////////////////////////////////
-__kernel void matrixmult(const __global int *a, const __global int *b, __global int *c) {
-	const int w = get_global_size(0);
-	const int h = get_global_size(1);
+// n x n matrices; the global range may be padded to multiples of the work-group size
+__kernel void matrixmult(const __global int *a, const __global int *b, __global int *c, const int n) {
 	const int x = get_global_id(0);
 	const int y = get_global_id(1);
+	if (x >= n || y >= n) return;
 	
 	int value = 0;
-	for(int i = 0; i < w; i++) {
-		int valA = a[y * w + i];
-		int valB = b[i * w + x];
+	for(int i = 0; i < n; i++) {
+		int valA = a[y * n + i];
+		int valB = b[i * n + x];
 		value += valA * valB;
 	}
 
-	c[y * w + x] = value;
+	c[y * n + x] = value;
 }
 
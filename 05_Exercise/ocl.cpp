@@ -1,125 +1,86 @@
-#include <fstream>
 #include <string>
 #include <vector>
-#include <utility>
 #include <iostream>
 #include <cassert>
+#include <thread>
 #include "ocl.h"
+#include "Runtime.h"
+#include "WorkGroupTuner.h"
+#include "MemoryPool.h"
 
 using namespace std;
 
+////////////////////////////////////////////////////////////////////////
+// prototypes
+void matMultCPU(const int* a, const int* b, int* const c, const int n);
+
 ////////////////////////////////////////////////////////////////////////
 const int devType = CL_DEVICE_TYPE_GPU;
 
 ////////////////////////////////////////////////////////////////////////
+// fastest device of type devType of the runtime; without such a device or kernel the OCLData has no kernel and
+// matMultGPU runs the OpenMP implementation on all hardware threads
 OCLData initOCL(const char* kernelFileName, const char* kernelName) {
 	OCLData ocl;
-	vector<cl::Platform> platforms;
-	vector<cl::Device> devices;
-
-	//cout << "**************************************************************************" << endl;
-	try {
-		// discover all available platforms
-		cl::Platform::get(&platforms);
-		if (platforms.empty()) {
-			cerr << "Error: no OpenCL platform available" << endl;
-			return ocl;
-		}
-
-		string name, profile, version;
-		
-		for(cl::Platform& p: platforms) {
-			p.getInfo(CL_PLATFORM_NAME, &name);
-			p.getInfo(CL_PLATFORM_PROFILE, &profile);
-			p.getInfo(CL_PLATFORM_VERSION, &version);
-
-			vector<cl::Device> devs;
-
-			try {
-				// get GPUs of this platform
-				p.getDevices(devType, &devs);
-
-			} catch(cl::Error&) {
-				// there is no GPU on this platform
-			}
-
-			if (!devs.empty()) {
-				// show platform
-				//cout << "Platform " << name << " (" << version << ", " << profile << ")" << endl;
-
-				// discover all available GPUs on this platform
-				for(cl::Device& dev: devs) {
-					// get and show device information
-					cl_uint maxComputeUnits;		dev.getInfo(CL_DEVICE_MAX_COMPUTE_UNITS, &maxComputeUnits);
-					cl_uint maxDims;				dev.getInfo(CL_DEVICE_MAX_WORK_ITEM_DIMENSIONS, &maxDims);
-					vector<size_t> workitemSize;	dev.getInfo(CL_DEVICE_MAX_WORK_ITEM_SIZES, &workitemSize);
-					size_t workgroupSize;			dev.getInfo(CL_DEVICE_MAX_WORK_GROUP_SIZE, &workgroupSize); // product of all dimension
-					cl_ulong localMemSize;			dev.getInfo(CL_DEVICE_LOCAL_MEM_SIZE, &localMemSize);
-					//cout << "Max. Compute Units: " << maxComputeUnits << ", Max. Dimensions: " << maxDims << " [" << workitemSize[0] << "," << workitemSize[1] << "," << workitemSize[2] << "]" << endl;
-					//cout << "Max. Work Group Size: " << workgroupSize << ", Max. Local Mem Size: " << localMemSize << endl << endl;
-				}
-
-				if (devices.empty()) {
-					// create s_context and command s_queue for the first device
-					cl_context_properties cps[] = { CL_CONTEXT_PLATFORM, (cl_context_properties)(p)(), 0 };
-					ocl.m_context = cl::Context(devType, cps);
-					ocl.m_queue = cl::CommandQueue(ocl.m_context, devs[0]);
+	OCLRuntime& runtime = OCLRuntime::get();
+	OCLDevice *dev = runtime.fastest(devType);
 
-					// add first device
-					devices.push_back(devs[0]);
-				}
-			}
-		}
-
-		// read source file
-		ifstream file(kernelFileName);
-		if (!file.good()) {
-			perror("Error");
-			return ocl;
-		}
-		string prog(istreambuf_iterator<char>(file), (istreambuf_iterator<char>()));	// read in file and store it in string prog
-		file.close();
-		cl::Program::Sources progSource(1, make_pair(prog.c_str(), prog.length() + 1));	// create source code object
-
-		// compile and execute s_kernel code
-		cl::Program program(ocl.m_context, progSource);									// create program object
-	#ifdef _DEBUG
+	if (dev) {
+		string options;
+		bool useCache = true;
+#ifdef _DEBUG
 		if (devType == CL_DEVICE_TYPE_CPU) {
-			string s;
-			s.append("-g -s \"").append(kernelFileName).append("\"");
-			program.build(devices, s.c_str());											// start debugger
-		} else
-	#endif
-		{
-			program.build(devices);														// build the program for given devices
+			// start debugger: needs the source
+			options.append("-g -s \"").append(kernelFileName).append("\"");
+			useCache = false;
 		}
-		ocl.m_kernel = cl::Kernel(program, kernelName);									// create the s_kernel: must be the name of the s_kernel in the cl file
-
-		// get device infos
-		devices[0].getInfo(CL_DEVICE_MAX_COMPUTE_UNITS, &ocl.m_computeUnits);
-
-	} catch(cl::Error& err) {
-		cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
+#endif
+		ocl.m_context = dev->m_context;
+		ocl.m_queue = dev->m_queue;
+		ocl.m_kernel = runtime.getKernel(*dev, kernelFileName, kernelName, options, useCache);
 	}
-	//cout << "**************************************************************************" << endl;
+	// efficiency is relative to the compute units of the device or to the hardware threads of the fallback
+	ocl.m_computeUnits = ocl.m_kernel() ? dev->m_computeUnits : thread::hardware_concurrency();
+	printBackend(cout, kernelName, ocl.m_kernel() ? dev : nullptr, "OpenMP");
 	return ocl;
 }
 
 ////////////////////////////////////////////////////////////////////////
 void matMultGPU(OCLData& ocl, const int* a, const int* b, int* const c, const int n) {
-	size_t n2 = sizeof(int) * n * n;
-	cl::Buffer bufferA(ocl.m_context, CL_MEM_READ_ONLY, n2);
-	cl::Buffer bufferB(ocl.m_context, CL_MEM_READ_ONLY, n2);
-	cl::Buffer bufferC(ocl.m_context, CL_MEM_WRITE_ONLY, n2);
-
-	ocl.m_queue.enqueueWriteBuffer(bufferA, CL_TRUE, 0, n2, a);
-	ocl.m_queue.enqueueWriteBuffer(bufferB, CL_TRUE, 0, n2, b);
+	// native fallback
+	if (!ocl.m_kernel()) {
+		matMultCPU(a, b, c, n);
+		return;
+	}
 
-	ocl.m_kernel.setArg(0, bufferA);
-	ocl.m_kernel.setArg(1, bufferB);
-	ocl.m_kernel.setArg(2, bufferC);
-	
-	ocl.m_queue.enqueueNDRangeKernel(ocl.m_kernel, cl::NullRange, cl::NDRange(n, n), cl::NullRange);
+	try {
+		size_t n2 = sizeof(int) * n * n;
+		// pooled buffers of the size class of n2: they return to the pool at the end of the call, all commands are blocking
+		OCLMemoryPool& pool = OCLMemoryPool::get();
+		shared_ptr<cl::Buffer> bufferA = pool.acquireBuffer(ocl.m_context, CL_MEM_READ_ONLY, n2);
+		shared_ptr<cl::Buffer> bufferB = pool.acquireBuffer(ocl.m_context, CL_MEM_READ_ONLY, n2);
+		shared_ptr<cl::Buffer> bufferC = pool.acquireBuffer(ocl.m_context, CL_MEM_WRITE_ONLY, n2);
+		cl::Event event;
+
+		ocl.m_queue.enqueueWriteBuffer(*bufferA, CL_TRUE, 0, n2, a, nullptr, &event);
+		profile(ocl.m_profiler, event, "write A", OCLProfiler::Upload, n2);
+		ocl.m_queue.enqueueWriteBuffer(*bufferB, CL_TRUE, 0, n2, b, nullptr, &event);
+		profile(ocl.m_profiler, event, "write B", OCLProfiler::Upload, n2);
+
+		ocl.m_kernel.setArg(0, *bufferA);
+		ocl.m_kernel.setArg(1, *bufferB);
+		ocl.m_kernel.setArg(2, *bufferC);
+		ocl.m_kernel.setArg(3, n);
+
+		WorkGroupTuner::get().enqueue(ocl.m_queue, ocl.m_kernel, n, n, nullptr, &event);
+		profile(ocl.m_profiler, event, "matrixmult", OCLProfiler::Kernel);
+
+		ocl.m_queue.enqueueReadBuffer(*bufferC, CL_TRUE, 0, n2, c, nullptr, &event);
+		profile(ocl.m_profiler, event, "read C", OCLProfiler::Download, n2);
 
-	ocl.m_queue.enqueueReadBuffer(bufferC, CL_TRUE, 0, n2, c);
+	} catch(cl::Error& err) {
+		// the product is computed by the native implementation
+		cerr << "OpenCL error: " << err.what() << "(" << err.err() << "), switched to OpenMP" << endl;
+		matMultCPU(a, b, c, n);
+	}
 }
\ No newline at end of file
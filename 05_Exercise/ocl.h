@@ -4,6 +4,7 @@
 #define CL_USE_DEPRECATED_OPENCL_2_0_APIS
 #define __CL_ENABLE_EXCEPTIONS
 #include "cl.hpp"
+#include "Profiler.h"
 
 // http://www.khronos.org/registry/cl/specs/opencl-cplusplus-1.2.pdf	// C++ manual
 // http://www.khronos.org/registry/cl/specs/opencl-1.2.pdf				// C manual
@@ -16,6 +17,7 @@ struct OCLData {
 	cl::CommandQueue m_queue;
 	cl::Kernel m_kernel;
 	cl_uint m_computeUnits;
+	OCLProfiler *m_profiler = nullptr;	// records the transfers and kernels if set
 	// private part
 	size_t m_tileSizeZ = 1;
 };
\ No newline at end of file
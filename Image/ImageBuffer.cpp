@@ -0,0 +1,177 @@
+#ifdef WIN32
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <cstdlib>
+#include <sys/mman.h>
+#endif
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include "ImageBuffer.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+// allocation methods
+enum { Aligned, Pages, AdvisedHugePages, HugePages };
+
+////////////////////////////////////////////////////////////////////////
+static size_t roundUp(size_t n, size_t m) {
+	return (n + m - 1)/m*m;
+}
+
+////////////////////////////////////////////////////////////////////////
+ImageBuffer::ImageBuffer(FREE_IMAGE_TYPE type, int width, int height, int bpp, bool hugePages)
+	: m_type(type), m_width(width), m_height(height), m_bpp(bpp)
+{
+	m_stride = (int)roundUp(((size_t)width*bpp + 7)/8, Alignment);
+	m_size = max((size_t)m_stride*height, (size_t)Alignment);
+	hugePages = hugePages && m_size >= HugePageSize;
+
+#ifdef WIN32
+	if (hugePages) {
+		// needs the "Lock pages in memory" privilege, otherwise the allocation fails
+		const size_t large = GetLargePageMinimum();
+
+		if (large > 0) {
+			const size_t size = roundUp(m_size, large);
+			m_bits = static_cast<BYTE*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+			if (m_bits) {
+				m_size = size;
+				m_kind = HugePages;
+				return;
+			}
+		}
+	}
+	if (m_size >= HugePageSize) {
+		m_bits = static_cast<BYTE*>(VirtualAlloc(nullptr, m_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+		m_kind = Pages;
+	} else {
+		m_bits = static_cast<BYTE*>(_aligned_malloc(m_size, PageSize));
+		m_kind = Aligned;
+	}
+#else
+	if (hugePages) {
+		const size_t size = roundUp(m_size, HugePageSize);
+		void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+		if (p != MAP_FAILED) {
+			m_bits = static_cast<BYTE*>(p);
+			m_size = size;
+			m_kind = HugePages;
+			return;
+		}
+		// no reserved huge pages: ask for transparent huge pages instead
+		p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p != MAP_FAILED) {
+			madvise(p, size, MADV_HUGEPAGE);
+			m_bits = static_cast<BYTE*>(p);
+			m_size = size;
+			m_kind = AdvisedHugePages;
+			return;
+		}
+	}
+	if (posix_memalign(reinterpret_cast<void**>(&m_bits), PageSize, m_size) != 0) m_bits = nullptr;
+	m_kind = Aligned;
+#endif
+	if (!m_bits) throw bad_alloc();
+}
+
+////////////////////////////////////////////////////////////////////////
+ImageBuffer::~ImageBuffer() {
+#ifdef WIN32
+	if (m_kind == Aligned) {
+		_aligned_free(m_bits);
+	} else {
+		VirtualFree(m_bits, 0, MEM_RELEASE);
+	}
+#else
+	if (m_kind == Aligned) {
+		free(m_bits);
+	} else {
+		munmap(m_bits, m_size);
+	}
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////
+FIBITMAP* ImageBuffer::createBitmap() const {
+	return FreeImage_ConvertFromRawBitsEx(FALSE, m_bits, m_type, m_width, m_height, m_stride, m_bpp,
+		FI_RGBA_RED_MASK, FI_RGBA_GREEN_MASK, FI_RGBA_BLUE_MASK, FALSE);
+}
+
+////////////////////////////////////////////////////////////////////////
+shared_ptr<fipImage> ImagePool::acquire(FREE_IMAGE_TYPE type, int width, int height, int bpp) {
+	ImageBuffer *buffer = nullptr;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = find_if(m_free.begin(), m_free.end(), [&](const unique_ptr<ImageBuffer>& b) { return b->hasShape(type, width, height, bpp); });
+
+		if (it != m_free.end()) {
+			buffer = it->release();
+			m_free.erase(it);
+			m_reuses++;
+		} else {
+			m_allocations++;
+		}
+	}
+	if (!buffer) buffer = new ImageBuffer(type, width, height, bpp, m_hugePages);
+
+	fipImage *image = new fipImage();
+	*image = buffer->createBitmap();
+
+	// the deleter frees the bitmap header first and then returns the pixel memory to the pool
+	return shared_ptr<fipImage>(image, [this, buffer](fipImage *im) {
+		delete im;
+		release(buffer);
+	});
+}
+
+////////////////////////////////////////////////////////////////////////
+void ImagePool::release(ImageBuffer *buffer) {
+	lock_guard<mutex> lock(m_mutex);
+	m_free.emplace_back(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////
+void ImagePool::clear() {
+	lock_guard<mutex> lock(m_mutex);
+	m_free.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+bool isPageAligned(const fipImage& image) {
+	return reinterpret_cast<size_t>(image.getScanLine(0)) % ImageBuffer::PageSize == 0 && image.getScanWidth() % ImageBuffer::Alignment == 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+void copyPixels(const fipImage& source, fipImage& dest) {
+	assert(source.getWidth() == dest.getWidth() && source.getHeight() == dest.getHeight() && source.getBitsPerPixel() == dest.getBitsPerPixel());
+	const size_t n = source.getLine();
+
+	for(unsigned int y = 0; y < source.getHeight(); y++) {
+		memcpy(dest.getScanLine(y), source.getScanLine(y), n);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+void copyBorder(const fipImage& source, fipImage& dest, int width) {
+	assert(source.getWidth() == dest.getWidth() && source.getHeight() == dest.getHeight() && source.getBitsPerPixel() == dest.getBitsPerPixel());
+	const int h = source.getHeight();
+	const size_t n = source.getLine();
+	const size_t strip = min((size_t)width*source.getBitsPerPixel()/8, n);
+
+	for(int y = 0; y < h; y++) {
+		BYTE *d = dest.getScanLine(y);
+		const BYTE *s = source.getScanLine(y);
+
+		if (y < width || y >= h - width || 2*strip >= n) {
+			memcpy(d, s, n);
+		} else {
+			// left and right strip
+			memcpy(d, s, strip);
+			memcpy(d + n - strip, s + n - strip, strip);
+		}
+	}
+}
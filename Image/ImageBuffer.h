@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "FreeImagePlus.h"
+
+////////////////////////////////////////////////////////////////////////
+// Pixel memory for images: buffers start on a page boundary and rows are 64-byte aligned, hence OpenCL devices
+// sharing the host memory can use the pixels in place. Buffers of 2 MB and more can be backed by huge pages
+// (MAP_HUGETLB or transparent huge pages on Linux, MEM_LARGE_PAGES on Windows; falls back to normal pages).
+class ImageBuffer {
+	BYTE *m_bits = nullptr;
+	size_t m_size = 0;			// allocated bytes
+	int m_kind = 0;				// allocation method, needed to release the memory
+	FREE_IMAGE_TYPE m_type;
+	int m_width;
+	int m_height;
+	int m_bpp;
+	int m_stride;				// bytes per row, multiple of Alignment
+
+public:
+	static const int Alignment = 64;
+	static const size_t PageSize = 4096;
+	static const size_t HugePageSize = 2*1024*1024;
+
+	ImageBuffer(FREE_IMAGE_TYPE type, int width, int height, int bpp, bool hugePages);
+	ImageBuffer(const ImageBuffer&) = delete;
+	ImageBuffer& operator=(const ImageBuffer&) = delete;
+	~ImageBuffer();
+
+	BYTE* getBits() const { return m_bits; }
+	size_t getSize() const { return m_size; }
+	int getStride() const { return m_stride; }
+	bool usesHugePages() const { return m_kind >= 2; }
+	bool hasShape(FREE_IMAGE_TYPE type, int width, int height, int bpp) const { return type == m_type && width == m_width && height == m_height && bpp == m_bpp; }
+
+	// FreeImage bitmap header that refers to this buffer without copying; the buffer must outlive the bitmap
+	FIBITMAP* createBitmap() const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// Recycles image buffers of the same shape. Images acquired from the pool return their buffer when the
+// last shared_ptr is released. The pool is thread-safe and must outlive all images acquired from it.
+class ImagePool {
+	std::vector<std::unique_ptr<ImageBuffer>> m_free;
+	std::mutex m_mutex;
+	bool m_hugePages;
+	size_t m_allocations = 0;
+	size_t m_reuses = 0;
+
+	void release(ImageBuffer *buffer);
+
+public:
+	ImagePool(bool hugePages = true) : m_hugePages(hugePages) {}
+	ImagePool(const ImagePool&) = delete;
+	ImagePool& operator=(const ImagePool&) = delete;
+
+	// image with undefined content
+	std::shared_ptr<fipImage> acquire(FREE_IMAGE_TYPE type, int width, int height, int bpp);
+	// image of the same shape as the given image with undefined content
+	std::shared_ptr<fipImage> acquire(const fipImage& shape) { return acquire(shape.getImageType(), shape.getWidth(), shape.getHeight(), shape.getBitsPerPixel()); }
+
+	size_t getAllocations() const { return m_allocations; }
+	size_t getReuses() const { return m_reuses; }
+	void clear();
+};
+
+////////////////////////////////////////////////////////////////////////
+// true if the pixels start on a page boundary and the row stride is a multiple of ImageBuffer::Alignment,
+// e.g. images of an ImagePool; OpenCL needs such memory for zero-copy buffers (CL_MEM_USE_HOST_PTR)
+bool isPageAligned(const fipImage& image);
+
+// copies the pixels row by row; both images must have the same shape but may have different row strides
+void copyPixels(const fipImage& source, fipImage& dest);
+// copies only the pixels within the given distance to the image border, e.g. the part a filter leaves untouched
+void copyBorder(const fipImage& source, fipImage& dest, int width);
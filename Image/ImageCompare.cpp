@@ -0,0 +1,138 @@
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <emmintrin.h>
+#include "ImageCompare.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+ostream& operator<<(ostream& os, const ImageDiff& diff) {
+	os << (diff.isEqual() ? "same results" : "different results");
+	if (diff.m_maxError > 0) {
+		os << ", max. error = " << diff.m_maxError << ", mean error = " << diff.m_meanError << ", differing pixels = " << diff.m_pixels
+			<< " (" << 100.0*diff.m_pixels/max<size_t>(diff.m_compared, 1) << " %)";
+	}
+	return os;
+}
+
+////////////////////////////////////////////////////////////////////////
+// heatmap color of a pixel with the largest channel difference e
+static void heat(BYTE *p, int e, int tolerance) {
+	if (e == 0) {
+		p[0] = p[1] = p[2] = 0;
+	} else if (e <= tolerance) {
+		p[0] = 160;
+		p[1] = p[2] = 0;
+	} else {
+		p[0] = 0;
+		p[1] = (BYTE)min(16*(e - tolerance - 1), 255);
+		p[2] = 255;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+ImageDiff compareImages(const fipImage& im1, const fipImage& im2, int margin, int tolerance, fipImage* heatmap) {
+	assert(im1.getWidth() == im2.getWidth() && im1.getHeight() == im2.getHeight() && im1.getBitsPerPixel() == im2.getBitsPerPixel());
+	assert(im1.getImageType() == im2.getImageType());
+	const int w = im1.getWidth();
+	const int h = im1.getHeight();
+	const int bypp = im1.getBitsPerPixel()/8;
+	const bool wide = im1.getImageType() == FIT_UINT16;		// 16-bit channels
+	const int channels = wide ? bypp/2 : bypp;
+	const int x0 = min(margin, w);
+	const int x1 = max(w - margin, x0);
+	const int n = x1 - x0;
+	ImageDiff diff;
+	double sum = 0;
+
+	if (heatmap) {
+		heatmap->setSize(FIT_BITMAP, w, h, 24);
+		for(int y = 0; y < h; y++) memset(heatmap->getScanLine(y), 0, 3*w);
+	}
+
+	#pragma omp parallel
+	{
+		vector<BYTE> rowDiff(bypp*n);
+		unsigned long long tSum = 0;
+		int tMax = 0;
+		size_t tPixels = 0;
+
+		#pragma omp for
+		for(int y = margin; y < h - margin; y++) {
+			BYTE *hC = heatmap ? heatmap->getScanLine(y) + 3*x0 : nullptr;
+
+			if (wide) {
+				const unsigned short *r1 = reinterpret_cast<const unsigned short*>(im1.getScanLine(y)) + channels*x0;
+				const unsigned short *r2 = reinterpret_cast<const unsigned short*>(im2.getScanLine(y)) + channels*x0;
+
+				for(int x = 0; x < n; x++) {
+					int e = 0;
+
+					for(int c = 0; c < channels; c++) {
+						const int d = abs(r1[channels*x + c] - r2[channels*x + c]);
+						tSum += d;
+						e = max(e, d);
+					}
+					tMax = max(tMax, e);
+					if (e > tolerance) tPixels++;
+					if (hC) heat(hC + 3*x, e, tolerance);
+				}
+				continue;
+			}
+
+			// absolute differences of all bytes with SSE2: sum and maximum, the differences are kept for the pixel pass
+			const BYTE *r1 = im1.getScanLine(y) + bypp*x0;
+			const BYTE *r2 = im2.getScanLine(y) + bypp*x0;
+			const int bytes = bypp*n;
+			const __m128i zero = _mm_setzero_si128();
+			__m128i vSum = zero, vMax = zero;
+			int i = 0;
+
+			for(; i + 16 <= bytes; i += 16) {
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + i));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r2 + i));
+				const __m128i d = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+
+				vSum = _mm_add_epi64(vSum, _mm_sad_epu8(d, zero));
+				vMax = _mm_max_epu8(vMax, d);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(rowDiff.data() + i), d);
+			}
+
+			alignas(16) unsigned long long sums[2];
+			alignas(16) BYTE maxs[16];
+			_mm_store_si128(reinterpret_cast<__m128i*>(sums), vSum);
+			_mm_store_si128(reinterpret_cast<__m128i*>(maxs), vMax);
+			tSum += sums[0] + sums[1];
+			tMax = max(tMax, (int)*max_element(maxs, maxs + 16));
+			for(; i < bytes; i++) {
+				const int d = abs(r1[i] - r2[i]);
+				rowDiff[i] = (BYTE)d;
+				tSum += d;
+				tMax = max(tMax, d);
+			}
+
+			// pixels: largest channel difference
+			for(int x = 0; x < n; x++) {
+				const BYTE *dC = rowDiff.data() + bypp*x;
+				int e = dC[0];
+
+				for(int c = 1; c < bypp; c++) e = max(e, (int)dC[c]);
+				if (e > tolerance) tPixels++;
+				if (hC) heat(hC + 3*x, e, tolerance);
+			}
+		}
+
+		#pragma omp critical
+		{
+			sum += (double)tSum;
+			diff.m_maxError = max(diff.m_maxError, tMax);
+			diff.m_pixels += tPixels;
+		}
+	}
+
+	diff.m_compared = (size_t)n*max(h - 2*margin, 0);
+	if (diff.m_compared > 0) diff.m_meanError = sum/((double)diff.m_compared*channels);
+	return diff;
+}
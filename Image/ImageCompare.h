@@ -0,0 +1,25 @@
+#pragma once
+
+#include <ostream>
+#include "FreeImagePlus.h"
+
+////////////////////////////////////////////////////////////////////////
+// Differences between two images of the same shape, e.g. the results of two backends
+struct ImageDiff {
+	int m_maxError = 0;			// largest absolute channel difference
+	double m_meanError = 0;		// mean absolute channel difference
+	size_t m_pixels = 0;		// pixels with a channel difference beyond the tolerance
+	size_t m_compared = 0;		// pixels compared
+
+	bool isEqual() const { return m_pixels == 0; }
+};
+
+// "same results" or "different results" followed by the errors and the share of differing pixels
+std::ostream& operator<<(std::ostream& os, const ImageDiff& diff);
+
+////////////////////////////////////////////////////////////////////////
+// Compares all pixels but a border of the given width in parallel, 8-bit channels with SSE2.
+// Channel differences up to the tolerance count as equal, e.g. 1 for approximate square roots.
+// heatmap (optional) receives a 24-bit image of the differences: black where the pixels are equal,
+// blue within the tolerance and red turning into yellow with growing difference beyond it.
+ImageDiff compareImages(const fipImage& im1, const fipImage& im2, int margin = 0, int tolerance = 0, fipImage* heatmap = nullptr);
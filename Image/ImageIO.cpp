@@ -0,0 +1,161 @@
+#include <fstream>
+#include <algorithm>
+#include "ImageIO.h"
+#include "Stopwatch.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+bool readFile(const char* fileName, vector<BYTE>& data) {
+	ifstream file(fileName, ios::binary | ios::ate);
+	if (!file) return false;
+
+	const streamsize size = file.tellg();
+	data.resize((size_t)size);
+	file.seekg(0);
+	return size > 0 && file.read(reinterpret_cast<char*>(data.data()), size);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool writeFile(const char* fileName, const BYTE* data, size_t size) {
+	ofstream file(fileName, ios::binary | ios::trunc);
+	return file && file.write(reinterpret_cast<const char*>(data), size);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool decodeImage(vector<BYTE>& data, fipImage& image) {
+	fipMemoryIO memory(data.data(), (DWORD)data.size());
+	return image.loadFromMemory(memory) == TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool encodeImage(const fipImage& image, const char* fileName, fipMemoryIO& memory) {
+	const FREE_IMAGE_FORMAT fif = FreeImage_GetFIFFromFilename(fileName);
+
+	if (fif == FIF_UNKNOWN || !FreeImage_FIFSupportsWriting(fif)) return false;
+	return image.saveToMemory(fif, memory) == TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool loadImage(const char* fileName, fipImage& image, MappedImage& mapping) {
+	vector<BYTE> data;
+
+	if (isRawImageFile(fileName)) return loadRawImage(fileName, image, mapping);
+	return readFile(fileName, data) && decodeImage(data, image);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool saveImage(const fipImage& image, const char* fileName) {
+	fipMemoryIO memory;
+	BYTE *data = nullptr;
+	DWORD size = 0;
+
+	if (isRawImageFile(fileName)) return saveRawImage(image, fileName);
+	return encodeImage(image, fileName, memory) && memory.acquire(&data, &size) && writeFile(fileName, data, size);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool loadPages(const char* fileName, vector<fipImage>& pages, MappedImage& mapping, int threads, vector<double>* decodeTimes) {
+	vector<BYTE> data;
+	vector<double> times(1);
+	Stopwatch sw;
+	bool ok;
+
+	pages.clear();
+	if (isRawImageFile(fileName)) {
+		// a raw image is mapped: there is nothing to decode
+		pages.resize(1);
+		if (decodeTimes) *decodeTimes = times;
+		return loadRawImage(fileName, pages[0], mapping);
+	}
+	if (!readFile(fileName, data)) return false;
+
+	// count the pages
+	fipMemoryIO memory(data.data(), (DWORD)data.size());
+	const FREE_IMAGE_FORMAT fif = memory.getFileType();
+	int count = 1;
+
+	if (fif == FIF_TIFF || fif == FIF_GIF || fif == FIF_ICO) {
+		FIMULTIBITMAP *multi = memory.loadMultiPage(fif);
+
+		if (multi) {
+			count = FreeImage_GetPageCount(multi);
+			FreeImage_CloseMultiBitmap(multi);
+		}
+	}
+	if (count <= 1) {
+		pages.resize(1);
+		sw.Start();
+		ok = decodeImage(data, pages[0]);
+		sw.Stop();
+		times[0] = sw.GetElapsedTimeMilliseconds();
+		if (decodeTimes) *decodeTimes = times;
+		return ok;
+	}
+
+	// decode the pages in parallel: a multi-page handle must not be shared between threads
+	if (threads <= 0) threads = max((int)thread::hardware_concurrency(), 1);
+	threads = min(threads, count);
+	pages.resize(count);
+	times.resize(count);
+
+	vector<thread> workers;
+	for(int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t] {
+			fipMemoryIO stream(data.data(), (DWORD)data.size());
+			FIMULTIBITMAP *multi = stream.loadMultiPage(fif);
+			if (!multi) return;
+
+			for(int p = t; p < count; p += threads) {
+				Stopwatch swPage;
+
+				swPage.Start();
+				FIBITMAP *dib = FreeImage_LockPage(multi, p);
+
+				if (dib) {
+					pages[p] = FreeImage_Clone(dib);
+					FreeImage_UnlockPage(multi, dib, FALSE);
+				}
+				swPage.Stop();
+				times[p] = swPage.GetElapsedTimeMilliseconds();
+			}
+			FreeImage_CloseMultiBitmap(multi);
+		});
+	}
+	for(thread& w: workers) w.join();
+
+	if (decodeTimes) *decodeTimes = times;
+	return all_of(pages.begin(), pages.end(), [](const fipImage& page) { return page.isValid() == TRUE; });
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ImageSaver::save(const fipImage& image, const string& fileName) {
+	const bool ok = wait();
+
+	m_thread = thread([this, &image, fileName] {
+		Stopwatch sw;
+
+		sw.Start();
+		m_ok = saveImage(image, fileName.c_str());
+		sw.Stop();
+		m_saveTime = sw.GetElapsedTimeMilliseconds();
+	});
+	return ok;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool ImageSaver::wait() {
+	if (m_thread.joinable()) {
+		Stopwatch sw;
+
+		sw.Start();
+		m_thread.join();
+		sw.Stop();
+		m_waitTime = sw.GetElapsedTimeMilliseconds();
+
+		// the saving thread has finished: its results can be read without a race until the next save() starts it again
+		m_lastOk = m_ok;
+		m_lastSaveTime = m_saveTime;
+	}
+	return m_lastOk;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "FreeImagePlus.h"
+#include "MappedImage.h"
+
+////////////////////////////////////////////////////////////////////////
+// Image I/O with file access separated from decoding: a file is read with a single read into memory and decoded
+// from there with fipMemoryIO, an image is encoded into memory and written with a single write.
+
+// whole file with one read
+bool readFile(const char* fileName, std::vector<BYTE>& data);
+// whole buffer with one write
+bool writeFile(const char* fileName, const BYTE* data, size_t size);
+
+// decodes any format FreeImage can load, the format is detected from the data
+bool decodeImage(std::vector<BYTE>& data, fipImage& image);
+// encodes the image in the format given by the extension of the file name
+bool encodeImage(const fipImage& image, const char* fileName, fipMemoryIO& memory);
+
+// loads raw images by mapping them and all other formats with FreeImage; the mapping must outlive the image
+bool loadImage(const char* fileName, fipImage& image, MappedImage& mapping);
+// saves raw images or any format FreeImage supports, chosen by the file extension
+bool saveImage(const fipImage& image, const char* fileName);
+
+// loads all pages of a multi-page image (TIFF, GIF, ICO); every thread opens its own multi-page handle on the
+// file data and decodes every threads-th page. Single-page formats and raw images yield one page.
+// decodeTimes receives the decode time of every page in ms (without reading the file).
+bool loadPages(const char* fileName, std::vector<fipImage>& pages, MappedImage& mapping, int threads = 0, std::vector<double>* decodeTimes = nullptr);
+
+////////////////////////////////////////////////////////////////////////
+// Saves an image on a background thread, e.g. while the next image is computed.
+// The image must not be changed or destroyed until wait() has returned.
+class ImageSaver {
+	std::thread m_thread;
+	bool m_ok = true;			// written by the saving thread
+	double m_saveTime = 0;		// encode and write time in ms, written by the saving thread
+	bool m_lastOk = true;		// result and time of the last image waited for, copied after joining
+	double m_lastSaveTime = 0;
+	double m_waitTime = 0;		// time the caller was blocked in wait() in ms
+
+public:
+	ImageSaver() {}
+	ImageSaver(const ImageSaver&) = delete;
+	ImageSaver& operator=(const ImageSaver&) = delete;
+	~ImageSaver() { wait(); }
+
+	// waits for the previous image and starts saving the given one; returns false if the previous image could not be saved
+	bool save(const fipImage& image, const std::string& fileName);
+	// returns false if the last image could not be saved
+	bool wait();
+
+	// times of the last image waited for, e.g. the previous image after save()
+	double getSaveTime() const { return m_lastSaveTime; }
+	double getWaitTime() const { return m_waitTime; }
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include "FreeImagePlus.h"
+
+////////////////////////////////////////////////////////////////////////
+// Pixel formats: T is the channel type, C the number of channels stored per pixel
+enum class PixelFormat { Gray8, Gray16, BGR24, BGRA32 };
+
+template<typename T, int C> struct PixelFormatOf;
+template<> struct PixelFormatOf<BYTE, 1> { static const PixelFormat Format = PixelFormat::Gray8; };
+template<> struct PixelFormatOf<WORD, 1> { static const PixelFormat Format = PixelFormat::Gray16; };
+template<> struct PixelFormatOf<BYTE, 3> { static const PixelFormat Format = PixelFormat::BGR24; };
+template<> struct PixelFormatOf<BYTE, 4> { static const PixelFormat Format = PixelFormat::BGRA32; };
+
+////////////////////////////////////////////////////////////////////////
+// Non-owning typed view of the pixels of an image: pointer, width, height, stride and format.
+// All accessors are inline, so per-pixel access costs no more than hand-written pointer arithmetic.
+// Rows are numbered like fipImage scanlines (bottom-up); a pixel is a pointer to its C channels.
+// Use a const channel type (e.g. ImageView<const BYTE, 4>) for read-only views.
+template<typename T, int C = 1>
+class ImageView {
+	typedef typename std::conditional<std::is_const<T>::value, const BYTE, BYTE>::type Byte;
+	typedef typename std::remove_const<T>::type Channel;
+
+	Byte *m_bits;
+	int m_width;
+	int m_height;
+	ptrdiff_t m_stride;		// bytes per row
+
+public:
+	static const int Channels = C;
+	static const PixelFormat Format = PixelFormatOf<Channel, C>::Format;
+
+	////////////////////////////////////////////////////////////////////////
+	// Neighbourhood of one pixel: (dx, dy) addresses the pixel at the given offset
+	class Window {
+		Byte *m_center;
+		ptrdiff_t m_stride;
+
+	public:
+		Window(Byte *center, ptrdiff_t stride) : m_center(center), m_stride(stride) {}
+		T* operator()(int dx, int dy) const { return reinterpret_cast<T*>(m_center + dy*m_stride) + C*dx; }
+		void moveRight() { m_center += C*sizeof(T); }
+	};
+
+	////////////////////////////////////////////////////////////////////////
+	// Pixels of one row in increasing x: for(T *p: view.row(y)) visits p[0..C-1] of every pixel
+	class Row {
+		T *m_begin, *m_end;
+
+	public:
+		class Iterator {
+			T *m_p;
+
+		public:
+			Iterator(T *p) : m_p(p) {}
+			T* operator*() const { return m_p; }
+			Iterator& operator++() { m_p += C; return *this; }
+			bool operator!=(const Iterator& it) const { return m_p != it.m_p; }
+		};
+
+		Row(T *begin, int width) : m_begin(begin), m_end(begin + C*width) {}
+		Iterator begin() const { return Iterator(m_begin); }
+		Iterator end() const { return Iterator(m_end); }
+		T* operator[](int x) const { return m_begin + C*x; }
+	};
+
+	ImageView(Byte *bits, int width, int height, ptrdiff_t stride) : m_bits(bits), m_width(width), m_height(height), m_stride(stride) {}
+	ImageView(const fipImage& image) : m_bits(image.getScanLine(0)), m_width(image.getWidth()), m_height(image.getHeight()), m_stride(image.getScanWidth()) {
+		assert(image.getBitsPerPixel() == 8*sizeof(T)*C);
+	}
+
+	int getWidth() const { return m_width; }
+	int getHeight() const { return m_height; }
+	ptrdiff_t getStride() const { return m_stride; }
+	bool contains(int x, int y) const { return x >= 0 && x < m_width && y >= 0 && y < m_height; }
+
+	T* rowPtr(int y) const { return reinterpret_cast<T*>(m_bits + y*m_stride); }
+	Row row(int y) const { return Row(rowPtr(y), m_width); }
+	T* operator()(int x, int y) const { return rowPtr(y) + C*x; }
+	Window window(int x, int y) const { return Window(m_bits + y*m_stride + C*sizeof(T)*x, m_stride); }
+};
+
+typedef ImageView<BYTE, 4> BGRAView;
+typedef ImageView<const BYTE, 4> ConstBGRAView;
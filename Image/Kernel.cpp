@@ -0,0 +1,248 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "Kernel.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+Kernel::Kernel(int size)
+	: m_size(size), m_name("zero"), m_weights(size*size, 0)
+{
+	analyze();
+}
+
+////////////////////////////////////////////////////////////////////////
+Kernel::Kernel(int size, const vector<int>& weights, int divisor, const string& name)
+	: m_size(size), m_divisor((divisor != 0) ? divisor : 1), m_name(name), m_weights(weights)
+{
+	m_weights.resize(size*size, 0);
+	analyze();
+}
+
+////////////////////////////////////////////////////////////////////////
+static int gcd(int a, int b) {
+	while(b != 0) {
+		const int t = a%b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+////////////////////////////////////////////////////////////////////////
+// rank-1 test with integer factors and a greedy partition of the non-zero weights into rectangles of equal weight
+void Kernel::analyze() {
+	const int n = m_size;
+	int r0 = -1, c0 = -1;
+
+	m_taps = 0;
+	for(int i = 0; i < n*n; i++) {
+		if (m_weights[i] == 0) continue;
+		if (m_taps++ == 0) {
+			r0 = i/n;
+			c0 = i%n;
+		}
+	}
+
+	// separability: all rows are integer multiples of the primitive part of the first non-zero row
+	m_column.clear();
+	m_row.clear();
+	if (r0 < 0) {
+		m_column.assign(n, 0);
+		m_row.assign(n, 0);
+	} else {
+		int g = 0;
+		for(int x = 0; x < n; x++) g = gcd(g, abs((*this)(x, r0)));
+		m_row.resize(n);
+		m_column.resize(n);
+		for(int x = 0; x < n; x++) m_row[x] = (*this)(x, r0)/g;
+		for(int y = 0; y < n; y++) m_column[y] = (*this)(c0, y)/m_row[c0];
+
+		for(int y = 0; y < n && !m_row.empty(); y++) {
+			for(int x = 0; x < n; x++) {
+				if (m_column[y]*m_row[x] != (*this)(x, y)) {
+					m_column.clear();
+					m_row.clear();
+					break;
+				}
+			}
+		}
+	}
+
+	// boxes: extend every uncovered weight to the right and then downwards as long as the weights are equal
+	vector<char> covered(n*n, 0);
+	m_boxes.clear();
+	for(int y = 0; y < n; y++) {
+		for(int x = 0; x < n; x++) {
+			const int w = (*this)(x, y);
+			if (w == 0 || covered[y*n + x]) continue;
+
+			int x1 = x + 1, y1 = y + 1;
+			while(x1 < n && !covered[y*n + x1] && (*this)(x1, y) == w) x1++;
+			for(bool equal = true; equal && y1 < n; ) {
+				for(int i = x; i < x1 && equal; i++) equal = !covered[y1*n + i] && (*this)(i, y1) == w;
+				if (equal) y1++;
+			}
+			for(int j = y; j < y1; j++) {
+				for(int i = x; i < x1; i++) covered[j*n + i] = 1;
+			}
+			m_boxes.push_back({ x, y, x1, y1, w });
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+Kernel Kernel::prewitt(int size) {
+	vector<int> weights(size*size, 0);
+
+	for(int x = 0; x < size; x++) {
+		weights[(size/2 - 1)*size + x] = 1;
+		weights[(size/2 + 1)*size + x] = -1;
+	}
+	return Kernel(size, weights, 1, "prewitt" + to_string(size));
+}
+
+////////////////////////////////////////////////////////////////////////
+Kernel Kernel::sobel() {
+	return Kernel(3, { 1, 2, 1, 0, 0, 0, -1, -2, -1 }, 1, "sobel");
+}
+
+////////////////////////////////////////////////////////////////////////
+Kernel Kernel::scharr() {
+	return Kernel(3, { 3, 10, 3, 0, 0, 0, -3, -10, -3 }, 1, "scharr");
+}
+
+////////////////////////////////////////////////////////////////////////
+Kernel Kernel::laplacian() {
+	return Kernel(3, { 0, 1, 0, 1, -4, 1, 0, 1, 0 }, 1, "laplacian");
+}
+
+////////////////////////////////////////////////////////////////////////
+// outer product of the binomial coefficients of order size - 1, the divisor is their total sum
+Kernel Kernel::gaussian(int size) {
+	vector<int> binomial(size, 0), weights(size*size);
+
+	binomial[0] = 1;
+	for(int k = 1; k < size; k++) {
+		for(int i = k; i > 0; i--) binomial[i] += binomial[i - 1];
+	}
+	for(int y = 0; y < size; y++) {
+		for(int x = 0; x < size; x++) weights[y*size + x] = binomial[y]*binomial[x];
+	}
+	return Kernel(size, weights, 1 << (2*(size - 1)), "gaussian" + to_string(size));
+}
+
+////////////////////////////////////////////////////////////////////////
+Kernel Kernel::box(int size) {
+	return Kernel(size, vector<int>(size*size, 1), size*size, "box" + to_string(size));
+}
+
+////////////////////////////////////////////////////////////////////////
+Kernel Kernel::transposed() const {
+	vector<int> weights(m_size*m_size);
+
+	for(int y = 0; y < m_size; y++) {
+		for(int x = 0; x < m_size; x++) weights[x*m_size + y] = (*this)(x, y);
+	}
+	return Kernel(m_size, weights, m_divisor, m_name + "T");
+}
+
+////////////////////////////////////////////////////////////////////////
+string Kernel::getShape() const {
+	ostringstream shape;
+
+	shape << m_size << "x" << m_size << (isSeparable() ? " separable " : " dense ") << m_boxes.size() << " boxes " << m_taps << " taps";
+	if (m_divisor != 1) shape << " divisor " << m_divisor;
+	return shape.str();
+}
+
+////////////////////////////////////////////////////////////////////////
+bool loadKernels(const char* fileName, vector<Kernel>& kernels) {
+	ifstream file(fileName);
+	if (!file) return false;
+
+	vector<vector<int>> rows;
+	int divisor = 1;
+	string line;
+	bool ok = true;
+
+	// completes the kernel of the collected rows
+	auto finish = [&]() {
+		if (rows.empty()) return;
+
+		const int size = (int)rows.size();
+		vector<int> weights;
+
+		for(const vector<int>& row: rows) {
+			if ((int)row.size() != size) ok = false;
+			weights.insert(weights.end(), row.begin(), row.end());
+		}
+		if ((size & 1) == 0) ok = false;
+		if (ok) kernels.push_back(Kernel(size, weights, divisor, string(fileName) + "[" + to_string(kernels.size()) + "]"));
+		rows.clear();
+		divisor = 1;
+	};
+
+	kernels.clear();
+	while(getline(file, line)) {
+		const size_t comment = line.find('#');
+		if (comment != string::npos) line.erase(comment);
+
+		istringstream values(line);
+		string word;
+		vector<int> row;
+
+		if (!(values >> word)) {
+			finish();
+			continue;
+		}
+		if (word == "divisor") {
+			values >> divisor;
+			continue;
+		}
+		row.push_back(atoi(word.c_str()));
+		for(int v; values >> v; ) row.push_back(v);
+		rows.push_back(row);
+	}
+	finish();
+	return ok && !kernels.empty();
+}
+
+////////////////////////////////////////////////////////////////////////
+// size suffix of built-in names, e.g. 7 for gaussian7
+static bool builtin(const char* spec, const char* name, int& size, int defaultSize) {
+	const size_t n = strlen(name);
+
+	if (strncmp(spec, name, n) != 0) return false;
+	size = (spec[n] != 0) ? atoi(spec + n) : defaultSize;
+	return size >= 1 && (size & 1) == 1;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool parseKernels(const char* spec, vector<Kernel>& kernels) {
+	int size;
+
+	kernels.clear();
+	if (builtin(spec, "prewitt", size, 3) && size >= 3) {
+		kernels.push_back(Kernel::prewitt(size));
+	} else if (strcmp(spec, "sobel") == 0) {
+		kernels.push_back(Kernel::sobel());
+	} else if (strcmp(spec, "scharr") == 0) {
+		kernels.push_back(Kernel::scharr());
+	} else if (strcmp(spec, "laplacian") == 0) {
+		kernels.push_back(Kernel::laplacian());
+		return true;
+	} else if (builtin(spec, "gaussian", size, 5) && size <= 11) {
+		kernels.push_back(Kernel::gaussian(size));
+		return true;
+	} else if (builtin(spec, "box", size, 3)) {
+		kernels.push_back(Kernel::box(size));
+		return true;
+	} else {
+		return loadKernels(spec, kernels);
+	}
+	kernels.push_back(kernels.front().transposed());
+	return true;
+}
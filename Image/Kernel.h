@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////
+// Square convolution kernel of odd size with integer weights; the filter response is the weighted sum divided
+// by the divisor. The structure relevant for choosing an implementation is analyzed on construction.
+class Kernel {
+public:
+	// rectangle [m_x0,m_x1) x [m_y0,m_y1) of equal weights
+	struct Box {
+		int m_x0, m_y0, m_x1, m_y1;
+		int m_weight;
+	};
+
+private:
+	int m_size = 1;
+	int m_divisor = 1;
+	std::string m_name;
+	std::vector<int> m_weights;		// row by row
+	std::vector<int> m_column;		// rank-1 kernels: weight(x, y) = m_column[y]*m_row[x], empty otherwise
+	std::vector<int> m_row;
+	std::vector<Box> m_boxes;		// partition of the non-zero weights into rectangles
+	int m_taps = 0;					// number of non-zero weights
+
+	void analyze();
+
+public:
+	Kernel() : m_weights(1, 0) {}
+	// zero kernel
+	explicit Kernel(int size);
+	Kernel(int size, const std::vector<int>& weights, int divisor = 1, const std::string& name = "custom");
+
+	// the hFilter family of the edge detection: +1 in the row above and -1 in the row below the center
+	static Kernel prewitt(int size);
+	static Kernel sobel();
+	static Kernel scharr();
+	static Kernel laplacian();
+	// binomial approximation of a Gaussian; the weights sum up to 4^(size - 1), hence size is limited to 11
+	static Kernel gaussian(int size);
+	static Kernel box(int size);
+
+	// kernel mirrored at the main diagonal, e.g. the vFilter belonging to an hFilter
+	Kernel transposed() const;
+
+	int getSize() const { return m_size; }
+	int getDivisor() const { return m_divisor; }
+	const std::string& getName() const { return m_name; }
+	const int* data() const { return m_weights.data(); }
+	int operator()(int x, int y) const { return m_weights[y*m_size + x]; }
+
+	bool isSeparable() const { return !m_row.empty(); }
+	const std::vector<int>& getColumn() const { return m_column; }
+	const std::vector<int>& getRow() const { return m_row; }
+	const std::vector<Box>& getBoxes() const { return m_boxes; }
+	int getTaps() const { return m_taps; }
+	// size, structure and divisor, e.g. "5x5 separable 2 boxes 10 taps"
+	std::string getShape() const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// Reads kernels from a text file: each kernel is a block of size lines of size integers, blocks are separated by
+// empty lines, a line "divisor n" sets the divisor of the following kernel and # starts a comment.
+bool loadKernels(const char* fileName, std::vector<Kernel>& kernels);
+
+// built-in kernels by name: prewitt<size>, sobel and scharr yield a pair (kernel and transposed kernel),
+// laplacian, gaussian<size> and box<size> a single kernel; any other name is read with loadKernels
+bool parseKernels(const char* spec, std::vector<Kernel>& kernels);
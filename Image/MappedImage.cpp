@@ -0,0 +1,166 @@
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <cstring>
+#include <cctype>
+#include "MappedImage.h"
+
+////////////////////////////////////////////////////////////////////////
+static size_t roundUp(size_t n, size_t m) {
+	return (n + m - 1)/m*m;
+}
+
+////////////////////////////////////////////////////////////////////////
+// maps the whole opened file
+bool MappedImage::map(size_t size, bool writable) {
+#ifdef WIN32
+	const DWORD protect = (writable) ? PAGE_READWRITE : PAGE_READONLY;
+
+	// a writable mapping of the given size also sets the file size
+	m_mapping = CreateFileMappingA(m_file, nullptr, protect, (DWORD)((uint64_t)size >> 32), (DWORD)size, nullptr);
+	if (!m_mapping) return false;
+	m_base = static_cast<BYTE*>(MapViewOfFile(m_mapping, (writable) ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size));
+#else
+	void *p = mmap(nullptr, size, PROT_READ | ((writable) ? PROT_WRITE : 0), MAP_SHARED, m_file, 0);
+
+	m_base = (p == MAP_FAILED) ? nullptr : static_cast<BYTE*>(p);
+#endif
+	m_size = size;
+	m_writable = writable;
+	return m_base != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool MappedImage::open(const char* fileName, bool writable) {
+	size_t size = 0;
+
+	close();
+#ifdef WIN32
+	m_file = CreateFileA(fileName, GENERIC_READ | ((writable) ? GENERIC_WRITE : 0), FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		m_file = nullptr;
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(m_file, &fileSize)) size = (size_t)fileSize.QuadPart;
+#else
+	m_file = ::open(fileName, (writable) ? O_RDWR : O_RDONLY);
+	if (m_file < 0) return false;
+
+	struct stat st;
+	if (fstat(m_file, &st) == 0) size = (size_t)st.st_size;
+#endif
+	if (size < RawImageHeader::Offset || !map(size, writable)) {
+		close();
+		return false;
+	}
+
+	// validate the header before any pixel is accessed; the pixel size is checked by division, because the product
+	// of a crafted stride and height could wrap around
+	const RawImageHeader& h = header();
+	if (h.m_magic != RawImageHeader::Magic || h.m_version != RawImageHeader::Version || h.m_offset < sizeof(RawImageHeader)
+		|| h.m_stride < ((uint64_t)h.m_width*h.m_bpp + 7)/8 || h.m_offset > size
+		|| (h.m_height != 0 && h.m_stride > (size - h.m_offset)/h.m_height)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool MappedImage::create(const char* fileName, FREE_IMAGE_TYPE type, int width, int height, int bpp) {
+	const size_t stride = roundUp(((size_t)width*bpp + 7)/8, Alignment);
+	const size_t size = RawImageHeader::Offset + stride*height;
+
+	close();
+#ifdef WIN32
+	m_file = CreateFileA(fileName, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		m_file = nullptr;
+		return false;
+	}
+#else
+	m_file = ::open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (m_file < 0) return false;
+	if (ftruncate(m_file, size) != 0) {
+		close();
+		return false;
+	}
+#endif
+	if (!map(size, true)) {
+		close();
+		return false;
+	}
+
+	RawImageHeader& h = *reinterpret_cast<RawImageHeader*>(m_base);
+	h.m_magic = RawImageHeader::Magic;
+	h.m_version = RawImageHeader::Version;
+	h.m_type = type;
+	h.m_width = width;
+	h.m_height = height;
+	h.m_bpp = bpp;
+	h.m_stride = stride;
+	h.m_offset = RawImageHeader::Offset;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+void MappedImage::close() {
+#ifdef WIN32
+	if (m_base) UnmapViewOfFile(m_base);
+	if (m_mapping) CloseHandle(m_mapping);
+	if (m_file) CloseHandle(m_file);
+	m_mapping = nullptr;
+	m_file = nullptr;
+#else
+	if (m_base) munmap(m_base, m_size);
+	if (m_file >= 0) ::close(m_file);
+	m_file = -1;
+#endif
+	m_base = nullptr;
+	m_size = 0;
+	m_writable = false;
+}
+
+////////////////////////////////////////////////////////////////////////
+FIBITMAP* MappedImage::createBitmap() const {
+	assert(isOpen());
+	return FreeImage_ConvertFromRawBitsEx(FALSE, getBits(), getImageType(), getWidth(), getHeight(), (int)getStride(), getBitsPerPixel(),
+		FI_RGBA_RED_MASK, FI_RGBA_GREEN_MASK, FI_RGBA_BLUE_MASK, FALSE);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool isRawImageFile(const char* fileName) {
+	const char* ext = strrchr(fileName, '.');
+	const char* raw = ".rimg";
+
+	if (!ext || strlen(ext) != strlen(raw)) return false;
+	for(; *ext; ext++, raw++) {
+		if (tolower((unsigned char)*ext) != *raw) return false;	// negative chars are undefined for tolower
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool saveRawImage(const fipImage& image, const char* fileName) {
+	MappedImage mapping;
+	const size_t n = image.getLine();
+
+	if (!image.isValid() || !mapping.create(fileName, image.getImageType(), image.getWidth(), image.getHeight(), image.getBitsPerPixel())) return false;
+	for(int y = 0; y < mapping.getHeight(); y++) {
+		memcpy(mapping.getBits() + y*mapping.getStride(), image.getScanLine(y), n);
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool loadRawImage(const char* fileName, fipImage& image, MappedImage& mapping) {
+	if (!mapping.open(fileName)) return false;
+	image = mapping.createBitmap();
+	return image.isValid() == TRUE;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include "FreeImagePlus.h"
+#include "ImageView.h"
+
+////////////////////////////////////////////////////////////////////////
+// Raw image file: a 4 KB header page followed by the rows in FreeImage order (bottom-up), each row 64-byte aligned.
+// The file is mapped into memory, hence opening it neither decodes nor reads pixels: pages are loaded on first access.
+struct RawImageHeader {
+	static const uint32_t Magic = 0x474D4952;	// "RIMG"
+	static const uint32_t Version = 1;
+	static const uint32_t Offset = 4096;		// start of the pixel data
+
+	uint32_t m_magic;
+	uint32_t m_version;
+	uint32_t m_type;		// FREE_IMAGE_TYPE
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_bpp;
+	uint64_t m_stride;		// bytes per row
+	uint64_t m_offset;		// bytes from the beginning of the file to the first row
+};
+
+////////////////////////////////////////////////////////////////////////
+// Memory mapping of a raw image file
+class MappedImage {
+	BYTE *m_base = nullptr;		// start of the mapping
+	size_t m_size = 0;			// mapped bytes
+	bool m_writable = false;
+#ifdef WIN32
+	void *m_file = nullptr;
+	void *m_mapping = nullptr;
+#else
+	int m_file = -1;
+#endif
+
+	const RawImageHeader& header() const { return *reinterpret_cast<const RawImageHeader*>(m_base); }
+	bool map(size_t size, bool writable);
+
+public:
+	static const int Alignment = 64;
+
+	MappedImage() {}
+	MappedImage(const MappedImage&) = delete;
+	MappedImage& operator=(const MappedImage&) = delete;
+	~MappedImage() { close(); }
+
+	// maps an existing raw image file; returns false if the file is missing or not a raw image
+	bool open(const char* fileName, bool writable = false);
+	// creates a raw image file of the given shape and maps it writable; the pixels are undefined
+	bool create(const char* fileName, FREE_IMAGE_TYPE type, int width, int height, int bpp);
+	void close();
+
+	bool isOpen() const { return m_base != nullptr; }
+	FREE_IMAGE_TYPE getImageType() const { return (FREE_IMAGE_TYPE)header().m_type; }
+	int getWidth() const { return header().m_width; }
+	int getHeight() const { return header().m_height; }
+	int getBitsPerPixel() const { return header().m_bpp; }
+	size_t getStride() const { return (size_t)header().m_stride; }
+	BYTE* getBits() const { return m_base + header().m_offset; }
+
+	template<typename T, int C> ImageView<T, C> view() const {
+		assert(sizeof(T)*C*8 == getBitsPerPixel());
+		return ImageView<T, C>(getBits(), getWidth(), getHeight(), (ptrdiff_t)getStride());
+	}
+
+	// FreeImage bitmap header that refers to the mapped rows without copying; the mapping must outlive the bitmap
+	FIBITMAP* createBitmap() const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// raw image files are recognized by the extension .rimg
+bool isRawImageFile(const char* fileName);
+
+// converters between raw image files and all formats FreeImage can load and save
+bool saveRawImage(const fipImage& image, const char* fileName);
+bool loadRawImage(const char* fileName, fipImage& image, MappedImage& mapping);
@@ -0,0 +1,131 @@
+#include <sstream>
+#include "MemoryPool.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+OCLMemoryPool& OCLMemoryPool::get() {
+	static OCLMemoryPool pool;
+	return pool;
+}
+
+////////////////////////////////////////////////////////////////////////
+size_t OCLMemoryPool::sizeClass(size_t size) {
+	const size_t MinSize = 4096;
+	if (size <= MinSize) return MinSize;
+
+	// four classes per power of two
+	size_t p = MinSize;
+	while(2*p <= size) p *= 2;
+	const size_t step = p/4;
+	return (size + step - 1)/step*step;
+}
+
+////////////////////////////////////////////////////////////////////////
+// most recently released entry of the key
+bool OCLMemoryPool::take(const string& key, Entry& entry) {
+	lock_guard<mutex> lock(m_mutex);
+
+	for(auto it = m_free.rbegin(); it != m_free.rend(); ++it) {
+		if (it->m_key == key) {
+			entry = *it;
+			m_free.erase(next(it).base());
+			m_stats.m_hits++;
+			m_stats.m_bytesHeld -= entry.m_bytes;
+			m_stats.m_bytesInUse += entry.m_bytes;
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLMemoryPool::release(Entry& entry) {
+	lock_guard<mutex> lock(m_mutex);
+
+	m_stats.m_bytesInUse -= entry.m_bytes;
+	m_stats.m_bytesHeld += entry.m_bytes;
+	m_free.push_back(entry);
+	trimLocked(m_limit);
+}
+
+////////////////////////////////////////////////////////////////////////
+shared_ptr<cl::Buffer> OCLMemoryPool::acquireBuffer(const cl::Context& context, cl_mem_flags flags, size_t size) {
+	ostringstream key;
+	Entry entry;
+
+	entry.m_bytes = sizeClass(size);
+	key << context() << " buffer " << flags << ' ' << entry.m_bytes;
+	entry.m_key = key.str();
+
+	if (!take(entry.m_key, entry)) {
+		// allocation errors are thrown before the statistics change
+		entry.m_buffer = cl::Buffer(context, flags, entry.m_bytes);
+
+		lock_guard<mutex> lock(m_mutex);
+		m_stats.m_misses++;
+		m_stats.m_bytesInUse += entry.m_bytes;
+	}
+	return shared_ptr<cl::Buffer>(new cl::Buffer(entry.m_buffer), [this, entry](cl::Buffer *buffer) mutable {
+		delete buffer;
+		release(entry);
+	});
+}
+
+////////////////////////////////////////////////////////////////////////
+shared_ptr<cl::Image2D> OCLMemoryPool::acquireImage(const cl::Context& context, cl_mem_flags flags, const cl::ImageFormat& format, size_t width, size_t height) {
+	ostringstream key;
+	Entry entry;
+
+	key << context() << " image " << flags << ' ' << format.image_channel_order << ' ' << format.image_channel_data_type << ' ' << width << 'x' << height;
+	entry.m_key = key.str();
+
+	if (!take(entry.m_key, entry)) {
+		entry.m_image = cl::Image2D(context, flags, format, width, height, 0);
+		entry.m_bytes = entry.m_image.getImageInfo<CL_IMAGE_ELEMENT_SIZE>()*width*height;
+
+		lock_guard<mutex> lock(m_mutex);
+		m_stats.m_misses++;
+		m_stats.m_bytesInUse += entry.m_bytes;
+	}
+	return shared_ptr<cl::Image2D>(new cl::Image2D(entry.m_image), [this, entry](cl::Image2D *image) mutable {
+		delete image;
+		release(entry);
+	});
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLMemoryPool::trimLocked(size_t limit) {
+	while(m_stats.m_bytesHeld > limit && !m_free.empty()) {
+		m_stats.m_bytesHeld -= m_free.front().m_bytes;
+		m_stats.m_trims++;
+		m_free.pop_front();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLMemoryPool::trim(size_t limit) {
+	lock_guard<mutex> lock(m_mutex);
+	trimLocked(limit);
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLMemoryPool::setLimit(size_t limit) {
+	lock_guard<mutex> lock(m_mutex);
+	m_limit = limit;
+	trimLocked(limit);
+}
+
+////////////////////////////////////////////////////////////////////////
+OCLMemoryPool::Statistics OCLMemoryPool::getStatistics() const {
+	lock_guard<mutex> lock(m_mutex);
+	return m_stats;
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLMemoryPool::print(ostream& os) const {
+	const Statistics s = getStatistics();
+
+	os << "OpenCL memory pool: " << s.m_hits << " hits, " << s.m_misses << " misses, " << s.m_trims << " trimmed, "
+		<< s.m_bytesHeld/(1024.0*1024) << " MB held, " << s.m_bytesInUse/(1024.0*1024) << " MB in use" << endl;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "ProgramCache.h"
+
+////////////////////////////////////////////////////////////////////////
+// Recycles device buffers and images across calls. Buffers are rounded up to size classes (four per power of two,
+// hence at most 25% waste), images are reused for the same format and size only. Memory acquired from the pool
+// returns to it when the last shared_ptr is released; the commands using it must have completed by then.
+// Free memory is kept up to a limit: beyond it the least recently released memory is freed (trim policy).
+// The pool is thread-safe and must outlive all memory acquired from it.
+class OCLMemoryPool {
+public:
+	static const size_t DefaultLimit = 256*1024*1024;
+
+	struct Statistics {
+		size_t m_hits = 0;			// acquisitions served from the free memory
+		size_t m_misses = 0;		// acquisitions that had to allocate
+		size_t m_trims = 0;			// free buffers and images released to the device
+		size_t m_bytesHeld = 0;		// free memory kept by the pool
+		size_t m_bytesInUse = 0;	// memory acquired and not yet released
+	};
+
+private:
+	// free buffer or image; key: context, flags and size class or image shape
+	struct Entry {
+		std::string m_key;
+		size_t m_bytes;
+		cl::Buffer m_buffer;
+		cl::Image2D m_image;
+	};
+
+	std::list<Entry> m_free;		// least recently released first
+	mutable std::mutex m_mutex;
+	size_t m_limit;
+	Statistics m_stats;
+
+	bool take(const std::string& key, Entry& entry);
+	void release(Entry& entry);
+	void trimLocked(size_t limit);
+
+public:
+	explicit OCLMemoryPool(size_t limit = DefaultLimit) : m_limit(limit) {}
+	OCLMemoryPool(const OCLMemoryPool&) = delete;
+	OCLMemoryPool& operator=(const OCLMemoryPool&) = delete;
+
+	// pool of the process
+	static OCLMemoryPool& get();
+
+	// buffer of at least size bytes with undefined content
+	std::shared_ptr<cl::Buffer> acquireBuffer(const cl::Context& context, cl_mem_flags flags, size_t size);
+	// image of the given format and size with undefined content
+	std::shared_ptr<cl::Image2D> acquireImage(const cl::Context& context, cl_mem_flags flags, const cl::ImageFormat& format, size_t width, size_t height);
+
+	// frees the least recently released memory until at most limit bytes are held
+	void trim(size_t limit);
+	void clear() { trim(0); }
+	void setLimit(size_t limit);
+	size_t getLimit() const { return m_limit; }
+
+	Statistics getStatistics() const;
+	void print(std::ostream& os) const;
+
+	// smallest size class not less than size
+	static size_t sizeClass(size_t size);
+};
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include "Profiler.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+static const char* KindNames[] = { "upload", "kernel", "download" };
+
+////////////////////////////////////////////////////////////////////////
+// start and end of the command in ns of the device clock
+static pair<cl_ulong, cl_ulong> interval(const cl::Event& event) {
+	return make_pair(event.getProfilingInfo<CL_PROFILING_COMMAND_START>(), event.getProfilingInfo<CL_PROFILING_COMMAND_END>());
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLProfiler::record(const cl::Event& event, const char* name, Kind kind, size_t bytes) {
+	if (event()) m_commands.push_back({ name, kind, bytes, event });
+}
+
+////////////////////////////////////////////////////////////////////////
+OCLProfiler::Summary OCLProfiler::summarize(double hostTime) const {
+	Summary s;
+	vector<pair<cl_ulong, cl_ulong>> intervals;
+
+	s.m_hostTime = hostTime;
+	try {
+		for(const Command& c: m_commands) {
+			c.m_event.wait();
+			const pair<cl_ulong, cl_ulong> t = interval(c.m_event);
+
+			s.m_commands[c.m_kind]++;
+			s.m_bytes[c.m_kind] += c.m_bytes;
+			s.m_time[c.m_kind] += (t.second - t.first)*1e-6;
+			intervals.push_back(t);
+		}
+	} catch(cl::Error& err) {
+		cerr << "OpenCL profiling error: " << err.what() << "(" << err.err() << ")" << endl;
+	}
+
+	// busy time: length of the union of all intervals, overlapping commands of several queues count once
+	sort(intervals.begin(), intervals.end());
+	cl_ulong busy = 0, start = 0, end = 0;
+	for(const pair<cl_ulong, cl_ulong>& t: intervals) {
+		if (t.first > end) {
+			busy += end - start;
+			start = t.first;
+			end = t.second;
+		} else {
+			end = max(end, t.second);
+		}
+	}
+	busy += end - start;
+	s.m_busyTime = busy*1e-6;
+	return s;
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLProfiler::print(ostream& os, double hostTime) const {
+	const Summary s = summarize(hostTime);
+
+	for(int k = Upload; k <= Download; k++) {
+		if (s.m_commands[k] == 0) continue;
+		os << "  " << KindNames[k] << ": " << s.m_commands[k] << " commands, " << s.m_time[k] << " ms";
+		if (k != Kernel) os << ", " << s.m_bytes[k]/(1024.0*1024) << " MB, " << s.getBandwidth((Kind)k) << " GB/s";
+		os << endl;
+	}
+	os << "  device busy: " << s.m_busyTime << " ms, host: " << s.m_hostTime << " ms, host overhead: " << s.getOverhead() << " ms" << endl;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool OCLProfiler::saveTrace(const char* fileName) const {
+	ofstream file(fileName);
+	if (!file.good()) return false;
+
+	vector<pair<cl_ulong, cl_ulong>> intervals;
+	cl_ulong first = ~cl_ulong(0);
+
+	try {
+		for(const Command& c: m_commands) {
+			c.m_event.wait();
+			intervals.push_back(interval(c.m_event));
+			first = min(first, intervals.back().first);
+		}
+	} catch(cl::Error& err) {
+		cerr << "OpenCL profiling error: " << err.what() << "(" << err.err() << ")" << endl;
+		return false;
+	}
+
+	// lane names first, then the commands
+	file << "{\"traceEvents\":[" << endl;
+	for(int k = Upload; k <= Download; k++) {
+		file << (k > Upload ? "," : "") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << k + 1 << ",\"args\":{\"name\":\"" << KindNames[k] << "\"}}" << endl;
+	}
+	for(size_t i = 0; i < m_commands.size(); i++) {
+		const Command& c = m_commands[i];
+
+		file << ",{\"name\":\"" << c.m_name << "\",\"cat\":\"" << KindNames[c.m_kind] << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << c.m_kind + 1
+			<< ",\"ts\":" << (intervals[i].first - first)*1e-3 << ",\"dur\":" << (intervals[i].second - intervals[i].first)*1e-3
+			<< ",\"args\":{\"bytes\":" << c.m_bytes << "}}" << endl;
+	}
+	file << "]}" << endl;
+	return file.good();
+}
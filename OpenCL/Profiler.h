@@ -0,0 +1,56 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ProgramCache.h"
+
+////////////////////////////////////////////////////////////////////////
+// Device timestamps (CL_PROFILING_COMMAND_START/END) of enqueued commands; the queues need CL_QUEUE_PROFILING_ENABLE,
+// which OCLRuntime sets. Commands are recorded with their event, the timestamps are read when the profile is
+// evaluated, hence after the commands have completed.
+class OCLProfiler {
+public:
+	enum Kind { Upload, Kernel, Download };
+
+	struct Command {
+		std::string m_name;
+		Kind m_kind;
+		size_t m_bytes;				// transferred bytes, 0 for kernels
+		cl::Event m_event;
+	};
+
+	// per kind: commands, bytes and device time; host overhead = host time - time the device was busy
+	struct Summary {
+		int m_commands[3] = { 0, 0, 0 };
+		size_t m_bytes[3] = { 0, 0, 0 };
+		double m_time[3] = { 0, 0, 0 };		// ms
+		double m_busyTime = 0;				// ms with at least one command running
+		double m_hostTime = 0;				// ms
+
+		double getBandwidth(Kind kind) const { return (m_time[kind] > 0) ? m_bytes[kind]/(m_time[kind]*1e6) : 0; }	// GB/s
+		double getOverhead() const { return (m_hostTime > m_busyTime) ? m_hostTime - m_busyTime : 0; }
+	};
+
+private:
+	std::vector<Command> m_commands;
+
+public:
+	void record(const cl::Event& event, const char* name, Kind kind, size_t bytes = 0);
+	void clear() { m_commands.clear(); }
+	bool isEmpty() const { return m_commands.empty(); }
+
+	// hostTime: ms measured on the host for the recorded commands, e.g. with a Stopwatch
+	Summary summarize(double hostTime) const;
+	// one line per kind with time and bandwidth, followed by the host overhead
+	void print(std::ostream& os, double hostTime) const;
+	// trace-event format (chrome://tracing, Perfetto): one complete event per command on a lane per kind,
+	// timestamps in us relative to the first command
+	bool saveTrace(const char* fileName) const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// records the command of the event if there is a profiler
+inline void profile(OCLProfiler* profiler, const cl::Event& event, const char* name, OCLProfiler::Kind kind, size_t bytes = 0) {
+	if (profiler) profiler->record(event, name, kind, bytes);
+}
@@ -0,0 +1,155 @@
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <cstdint>
+#include "ProgramCache.h"
+#include "Stopwatch.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+// FNV-1a hash of the strings, each one terminated by a zero byte
+static uint64_t hashStrings(const vector<string>& strings) {
+	uint64_t h = 14695981039346656037ull;
+
+	for(const string& s: strings) {
+		for(unsigned char c: s) {
+			h = (h ^ c)*1099511628211ull;
+		}
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+////////////////////////////////////////////////////////////////////////
+// cache file of the program for the given device
+static string cacheFileName(const char* name, const string& source, const string& options, const cl::Device& device) {
+	const uint64_t h = hashStrings({ source, options, device.getInfo<CL_DEVICE_NAME>(), device.getInfo<CL_DRIVER_VERSION>() });
+	ostringstream os;
+
+	os << name << '.' << hex << setw(16) << setfill('0') << h << ".bin";
+	return os.str();
+}
+
+////////////////////////////////////////////////////////////////////////
+// cache file: time of the source build in ms followed by the program binary
+static bool loadBinary(const string& fileName, vector<char>& binary, double& sourceTime) {
+	ifstream file(fileName, ios::binary);
+	if (!file.good()) return false;
+
+	file.read(reinterpret_cast<char*>(&sourceTime), sizeof(sourceTime));
+	binary.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+	return !binary.empty();
+}
+
+////////////////////////////////////////////////////////////////////////
+static void saveBinary(const string& fileName, const vector<char>& binary, double sourceTime) {
+	ofstream file(fileName, ios::binary);
+	if (!file.good()) return;
+
+	file.write(reinterpret_cast<const char*>(&sourceTime), sizeof(sourceTime));
+	file.write(binary.data(), binary.size());
+}
+
+////////////////////////////////////////////////////////////////////////
+// program binaries of all devices of the program
+static vector<vector<char>> getBinaries(const cl::Program& program) {
+	const vector<size_t> sizes = program.getInfo<CL_PROGRAM_BINARY_SIZES>();
+	vector<vector<char>> binaries(sizes.size());
+	vector<char*> pointers(sizes.size());
+
+	for(size_t i = 0; i < sizes.size(); i++) {
+		binaries[i].resize(sizes[i]);
+		pointers[i] = binaries[i].data();
+	}
+	// the C++ wrapper cannot fill preallocated buffers
+	const cl_int err = clGetProgramInfo(program(), CL_PROGRAM_BINARIES, pointers.size()*sizeof(char*), pointers.data(), nullptr);
+	if (err != CL_SUCCESS) throw cl::Error(err, "clGetProgramInfo");
+	return binaries;
+}
+
+////////////////////////////////////////////////////////////////////////
+// builds the program and prints the build log on failure
+static void build(cl::Program& program, const vector<cl::Device>& devices, const string& options) {
+	try {
+		program.build(devices, options.c_str());
+	} catch(cl::Error&) {
+		for(const cl::Device& dev: devices) {
+			cerr << program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(dev) << endl;
+		}
+		throw;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+cl::Program buildProgram(const cl::Context& context, const vector<cl::Device>& devices, const char* fileName, const string& options, bool useCache, ProgramInfo* info) {
+	// read source file
+	ifstream file(fileName);
+	if (!file.good()) {
+		perror("Error");
+		return cl::Program();
+	}
+	const string source(istreambuf_iterator<char>(file), (istreambuf_iterator<char>()));
+	file.close();
+
+	return buildProgramSource(context, devices, source, fileName, options, useCache, info);
+}
+
+////////////////////////////////////////////////////////////////////////
+cl::Program buildProgramSource(const cl::Context& context, const vector<cl::Device>& devices, const string& source, const char* name, const string& options, bool useCache, ProgramInfo* info) {
+	Stopwatch sw;
+	ProgramInfo pi;
+
+	sw.Start();
+
+	vector<string> cacheFiles;
+	for(const cl::Device& dev: devices) cacheFiles.push_back(cacheFileName(name, source, options, dev));
+
+	if (useCache) {
+		// all devices need a cached binary
+		vector<vector<char>> binaries(devices.size());
+		bool complete = !devices.empty();
+
+		for(size_t i = 0; complete && i < devices.size(); i++) {
+			complete = loadBinary(cacheFiles[i], binaries[i], pi.m_sourceTime);
+		}
+		if (complete) {
+			try {
+				cl::Program::Binaries bins;
+				for(const vector<char>& b: binaries) bins.push_back(make_pair(b.data(), b.size()));
+
+				cl::Program program(context, devices, bins);
+				program.build(devices, options.c_str());
+				sw.Stop();
+				pi.m_cached = true;
+				pi.m_time = sw.GetElapsedTimeMilliseconds();
+				if (info) *info = pi;
+				return program;
+			} catch(cl::Error&) {
+				// binary of another driver: build from source and replace it
+			}
+		}
+	}
+
+	// compile from source
+	cl::Program::Sources progSource(1, make_pair(source.c_str(), source.length() + 1));
+	cl::Program program(context, progSource);
+	build(program, devices, options);
+	sw.Stop();
+	pi.m_time = pi.m_sourceTime = sw.GetElapsedTimeMilliseconds();
+
+	if (useCache) {
+		// the order of the binaries is the order of the devices of the program
+		const vector<cl::Device> progDevices = program.getInfo<CL_PROGRAM_DEVICES>();
+		const vector<vector<char>> binaries = getBinaries(program);
+
+		for(size_t i = 0; i < progDevices.size(); i++) {
+			for(size_t j = 0; j < devices.size(); j++) {
+				if (devices[j]() == progDevices[i]() && !binaries[i].empty()) saveBinary(cacheFiles[j], binaries[i], pi.m_sourceTime);
+			}
+		}
+	}
+	if (info) *info = pi;
+	return program;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#define CL_USE_DEPRECATED_OPENCL_1_2_APIS
+#define CL_USE_DEPRECATED_OPENCL_2_0_APIS
+#define __CL_ENABLE_EXCEPTIONS
+#include "cl.hpp"
+
+////////////////////////////////////////////////////////////////////////
+// How buildProgram created the program
+struct ProgramInfo {
+	bool m_cached = false;		// loaded from the binary cache
+	double m_time = 0;			// ms to create and build the program
+	double m_sourceTime = 0;	// ms of the source build, also known for cached programs
+};
+
+////////////////////////////////////////////////////////////////////////
+// Builds the kernel source file for the devices of a context. Program binaries are kept next to the source file
+// (e.g. edges.cl.<hash>.bin), the hash covers the source, the build options, the device name and the driver version.
+// A binary that is missing or rejected by the driver is replaced by a build from source. useCache = false always
+// builds from source and leaves the cache untouched. Build errors throw cl::Error after printing the build log.
+cl::Program buildProgram(const cl::Context& context, const std::vector<cl::Device>& devices, const char* fileName, const std::string& options = "", bool useCache = true, ProgramInfo* info = nullptr);
+
+// the same for a source in memory; name replaces the file name in the names of the cache files
+cl::Program buildProgramSource(const cl::Context& context, const std::vector<cl::Device>& devices, const std::string& source, const char* name, const std::string& options = "", bool useCache = true, ProgramInfo* info = nullptr);
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include "Runtime.h"
+#include "Stopwatch.h"
+
+using namespace std;
+
+// error of clGetPlatformIDs if the ICD loader finds no platform (cl_ext.h)
+#ifndef CL_PLATFORM_NOT_FOUND_KHR
+#define CL_PLATFORM_NOT_FOUND_KHR -1001
+#endif
+
+////////////////////////////////////////////////////////////////////////
+// micro-benchmark: memory transfers and some arithmetic per element
+static const char* BenchmarkSource =
+	"__kernel void benchmark(__global float* a) {\n"
+	"	const int i = get_global_id(0);\n"
+	"	float x = a[i];\n"
+	"	for(int k = 0; k < 64; k++) x = mad(x, 0.999f, 0.001f);\n"
+	"	a[i] = x;\n"
+	"}\n";
+
+////////////////////////////////////////////////////////////////////////
+const char* OCLDevice::getTypeName() const {
+	if (m_type & CL_DEVICE_TYPE_GPU) return "GPU";
+	if (m_type & CL_DEVICE_TYPE_CPU) return "CPU";
+	return "accelerator";
+}
+
+////////////////////////////////////////////////////////////////////////
+OCLRuntime& OCLRuntime::get() {
+	static OCLRuntime runtime;
+	return runtime;
+}
+
+////////////////////////////////////////////////////////////////////////
+OCLRuntime::OCLRuntime() {
+	vector<cl::Platform> platforms;
+
+	try {
+		// discover all available platforms
+		string disable;
+
+		if (getEnvironment("OCL_DISABLE", disable)) {
+			cout << "OpenCL disabled by OCL_DISABLE" << endl;
+		} else {
+			cl::Platform::get(&platforms);
+		}
+	} catch(cl::Error& err) {
+		if (err.err() == CL_PLATFORM_NOT_FOUND_KHR) {
+			cout << "No OpenCL platform installed" << endl;
+		} else {
+			cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
+		}
+	}
+
+	for(cl::Platform& p: platforms) {
+		vector<cl::Device> devs;
+
+		try {
+			p.getDevices(CL_DEVICE_TYPE_ALL, &devs);
+		} catch(cl::Error&) {
+			// there is no device on this platform
+		}
+
+		for(cl::Device& d: devs) {
+			try {
+				// one context and queue per device; profiling costs little and makes OCLProfiler work on all queues
+				OCLDevice dev;
+				cl_bool unified = CL_FALSE;
+
+				dev.m_device = d;
+				dev.m_context = cl::Context(vector<cl::Device>(1, d));
+				dev.m_queue = cl::CommandQueue(dev.m_context, d, CL_QUEUE_PROFILING_ENABLE);
+				p.getInfo(CL_PLATFORM_NAME, &dev.m_platform);
+				d.getInfo(CL_DEVICE_NAME, &dev.m_name);
+				d.getInfo(CL_DEVICE_TYPE, &dev.m_type);
+				d.getInfo(CL_DEVICE_MAX_COMPUTE_UNITS, &dev.m_computeUnits);
+				d.getInfo(CL_DEVICE_MAX_WORK_GROUP_SIZE, &dev.m_maxWorkGroupSize);
+				d.getInfo(CL_DEVICE_LOCAL_MEM_SIZE, &dev.m_localMemSize);
+				d.getInfo(CL_DEVICE_HOST_UNIFIED_MEMORY, &unified);
+				dev.m_unifiedMemory = unified == CL_TRUE;
+				benchmark(dev);
+				m_devices.push_back(dev);
+			} catch(cl::Error& err) {
+				cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
+			}
+		}
+	}
+
+	stable_sort(m_devices.begin(), m_devices.end(), [](const OCLDevice& a, const OCLDevice& b) { return a.m_benchmarkTime < b.m_benchmarkTime; });
+	print(cout);
+}
+
+////////////////////////////////////////////////////////////////////////
+// best of three runs; devices failing the benchmark are ranked last
+void OCLRuntime::benchmark(OCLDevice& dev) {
+	const size_t n = 1 << 20;
+	vector<float> data(n, 1.0f);
+	Stopwatch sw;
+
+	dev.m_benchmarkTime = numeric_limits<double>::infinity();
+	try {
+		cl::Program program = buildProgramSource(dev.m_context, vector<cl::Device>(1, dev.m_device), BenchmarkSource, "benchmark.cl");
+		cl::Kernel kernel(program, "benchmark");
+		cl::Buffer buffer(dev.m_context, CL_MEM_READ_WRITE, n*sizeof(float));
+
+		kernel.setArg(0, buffer);
+		for(int r = 0; r < 3; r++) {
+			sw.Start();
+			dev.m_queue.enqueueWriteBuffer(buffer, CL_TRUE, 0, n*sizeof(float), data.data());
+			dev.m_queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(n), cl::NullRange);
+			dev.m_queue.enqueueReadBuffer(buffer, CL_TRUE, 0, n*sizeof(float), data.data());
+			sw.Stop();
+			dev.m_benchmarkTime = min(dev.m_benchmarkTime, sw.GetElapsedTimeMilliseconds());
+		}
+	} catch(cl::Error& err) {
+		cerr << "OpenCL error in benchmark of " << dev.m_name << ": " << err.what() << "(" << err.err() << ")" << endl;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+OCLDevice* OCLRuntime::fastest(cl_device_type type) {
+	for(OCLDevice& dev: m_devices) {
+		if (dev.m_type & type) return &dev;
+	}
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////
+OCLDevice* OCLRuntime::byName(const string& part) {
+	for(OCLDevice& dev: m_devices) {
+		if (dev.m_name.find(part) != string::npos) return &dev;
+	}
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////
+vector<OCLDevice*> OCLRuntime::all(cl_device_type type) {
+	vector<OCLDevice*> devs;
+
+	for(OCLDevice& dev: m_devices) {
+		if (dev.m_type & type) devs.push_back(&dev);
+	}
+	return devs;
+}
+
+////////////////////////////////////////////////////////////////////////
+cl::Kernel OCLRuntime::getKernel(OCLDevice& dev, const char* fileName, const char* kernelName, const string& options, bool useCache) {
+	const auto key = make_pair(dev.m_device(), string(fileName) + '\n' + options);
+
+	try {
+		auto it = m_programs.find(key);
+
+		if (it == m_programs.end()) {
+			// build the program or load it from the binary cache
+			ProgramInfo info;
+			cl::Program program = buildProgram(dev.m_context, vector<cl::Device>(1, dev.m_device), fileName, options, useCache, &info);
+			if (!program()) return cl::Kernel();
+
+			cout << fileName << " for " << dev.m_name << (info.m_cached ? " loaded from cache" : " built from source") << " in " << info.m_time << " ms";
+			if (info.m_cached) cout << " (" << info.m_sourceTime << " ms from source)";
+			cout << endl;
+			it = m_programs.insert(make_pair(key, program)).first;
+		}
+		return cl::Kernel(it->second, kernelName);		// must be the name of the kernel in the cl file
+
+	} catch(cl::Error& err) {
+		cerr << "OpenCL error: " << err.what() << "(" << err.err() << ")" << endl;
+		return cl::Kernel();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+void OCLRuntime::print(ostream& os) const {
+	os << "**************************************************************************" << endl;
+	if (m_devices.empty()) {
+		os << "No OpenCL device available" << endl;
+	}
+	for(size_t i = 0; i < m_devices.size(); i++) {
+		const OCLDevice& dev = m_devices[i];
+
+		os << i + 1 << ". " << dev.m_name << " (" << dev.m_platform << ", " << dev.getTypeName() << ")" << endl;
+		os << "   Max. Compute Units: " << dev.m_computeUnits << ", Max. Work Group Size: " << dev.m_maxWorkGroupSize << ", Max. Local Mem Size: " << dev.m_localMemSize << endl;
+		os << "   Host unified memory: " << (dev.m_unifiedMemory ? "yes" : "no") << ", benchmark: " << dev.m_benchmarkTime << " ms" << endl;
+	}
+	os << "**************************************************************************" << endl;
+}
+
+////////////////////////////////////////////////////////////////////////
+void printBackend(ostream& os, const char* operation, const OCLDevice* dev, const char* fallback) {
+	if (dev) {
+		os << operation << " backend: OpenCL on " << dev->m_name << " (" << dev->getTypeName() << ")" << endl;
+	} else {
+		os << operation << " backend: " << fallback << " (no OpenCL device or kernel)" << endl;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+bool getEnvironment(const char* name, string& value) {
+#ifdef _MSC_VER
+	char *p = nullptr;
+	size_t n = 0;
+
+	if (_dupenv_s(&p, &n, name) != 0 || !p) return false;
+	value = p;
+	free(p);
+#else
+	const char *p = getenv(name);
+
+	if (!p) return false;
+	value = p;
+#endif
+	return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ProgramCache.h"
+
+////////////////////////////////////////////////////////////////////////
+// OpenCL device with its own context and in-order command queue
+struct OCLDevice {
+	cl::Device m_device;
+	cl::Context m_context;
+	cl::CommandQueue m_queue;
+	std::string m_name;
+	std::string m_platform;
+	cl_device_type m_type;
+	cl_uint m_computeUnits;
+	size_t m_maxWorkGroupSize;
+	cl_ulong m_localMemSize;
+	bool m_unifiedMemory;		// device shares the host memory (CL_DEVICE_HOST_UNIFIED_MEMORY)
+	double m_benchmarkTime;		// ms of the micro-benchmark, the ranking criterion
+
+	// "GPU", "CPU" or "accelerator"
+	const char* getTypeName() const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// All OpenCL devices of all platforms, enumerated once per process and ranked by a micro-benchmark (upload,
+// arithmetic kernel and download of 4 MB). The exercises select devices by a policy and get ready-built kernels;
+// a program is built once per device, file and build options (see buildProgram for the binary cache).
+// Without a platform (no ICD installed) or with the environment variable OCL_DISABLE set there is no device;
+// the exercises then route their OpenCL entry points to their native CPU implementations.
+class OCLRuntime {
+	std::vector<OCLDevice> m_devices;				// fastest first
+	std::map<std::pair<cl_device_id, std::string>, cl::Program> m_programs;	// by device handle, file name and options; identical devices have their own contexts
+
+	OCLRuntime();
+	void benchmark(OCLDevice& dev);
+
+public:
+	OCLRuntime(const OCLRuntime&) = delete;
+	OCLRuntime& operator=(const OCLRuntime&) = delete;
+
+	// the runtime of the process, enumerates the devices on first use
+	static OCLRuntime& get();
+
+	const std::vector<OCLDevice>& getDevices() const { return m_devices; }
+
+	// selection policies: the device pointers stay valid for the lifetime of the process
+	// fastest device of the given type(s), nullptr if there is none
+	OCLDevice* fastest(cl_device_type type = CL_DEVICE_TYPE_ALL);
+	// fastest device whose name contains the given part
+	OCLDevice* byName(const std::string& part);
+	// all devices of the given type(s), fastest first
+	std::vector<OCLDevice*> all(cl_device_type type = CL_DEVICE_TYPE_ALL);
+
+	// new kernel object of a program built for the device; an empty kernel on errors (they are printed)
+	cl::Kernel getKernel(OCLDevice& dev, const char* fileName, const char* kernelName, const std::string& options = "", bool useCache = true);
+
+	// ranked device list
+	void print(std::ostream& os) const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// logs the backend chosen for an operation: OpenCL on the device or, if dev is null, the native fallback
+void printBackend(std::ostream& os, const char* operation, const OCLDevice* dev, const char* fallback);
+
+// value of an environment variable such as OCL_TRACE; false if it is not set (without the getenv warning of MSVC)
+bool getEnvironment(const char* name, std::string& value);
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "WorkGroupTuner.h"
+#include "Stopwatch.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////
+static size_t roundUp(size_t n, size_t multiple) {
+	return (n + multiple - 1)/multiple*multiple;
+}
+
+////////////////////////////////////////////////////////////////////////
+static size_t nextPowerOfTwo(size_t n) {
+	size_t p = 1;
+	while(p < n) p *= 2;
+	return p;
+}
+
+////////////////////////////////////////////////////////////////////////
+cl::NDRange LocalSize::getGlobal(size_t w, size_t h) const {
+	return isDriverChoice() ? cl::NDRange(w, h) : cl::NDRange(roundUp(w, m_x), roundUp(h, m_y));
+}
+
+////////////////////////////////////////////////////////////////////////
+string LocalSize::getName() const {
+	return isDriverChoice() ? "driver" : to_string(m_x) + "x" + to_string(m_y);
+}
+
+////////////////////////////////////////////////////////////////////////
+WorkGroupTuner::WorkGroupTuner(const char* fileName)
+	: m_fileName(fileName)
+{
+	load();
+}
+
+////////////////////////////////////////////////////////////////////////
+WorkGroupTuner& WorkGroupTuner::get() {
+	static WorkGroupTuner tuner("workgroups.txt");
+	return tuner;
+}
+
+////////////////////////////////////////////////////////////////////////
+string WorkGroupTuner::key(const cl::Device& dev, const cl::Kernel& kernel, size_t w, size_t h) const {
+	return kernel.getInfo<CL_KERNEL_FUNCTION_NAME>() + "; " + to_string(nextPowerOfTwo(w)) + "x" + to_string(nextPowerOfTwo(h))
+		+ "; " + dev.getInfo<CL_DEVICE_NAME>();
+}
+
+////////////////////////////////////////////////////////////////////////
+LocalSize WorkGroupTuner::select(cl::CommandQueue& queue, cl::Kernel& kernel, size_t w, size_t h, const vector<cl::Event>* events) {
+	const cl::Device dev = queue.getInfo<CL_QUEUE_DEVICE>();
+	const string k = key(dev, kernel, w, h);
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_decisions.find(k);
+		if (it != m_decisions.end()) return it->second;
+	}
+
+	// first use: tuning runs the kernel without the wait list; the threads of the co-execution tune different
+	// devices, hence outside of the lock
+	if (events && !events->empty()) cl::WaitForEvents(*events);
+	map<string, double> times;
+	const LocalSize best = tune(queue, kernel, dev, w, h, times);
+
+	lock_guard<mutex> lock(m_mutex);
+	m_decisions[k] = best;
+	m_times = times;
+	save();
+	return best;
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkGroupTuner::enqueue(cl::CommandQueue& queue, cl::Kernel& kernel, size_t w, size_t h, const vector<cl::Event>* events, cl::Event* event) {
+	enqueue(queue, kernel, cl::NullRange, w, h, events, event);
+}
+
+////////////////////////////////////////////////////////////////////////
+void WorkGroupTuner::enqueue(cl::CommandQueue& queue, cl::Kernel& kernel, const cl::NDRange& offset, size_t w, size_t h, const vector<cl::Event>* events, cl::Event* event) {
+	const LocalSize local = select(queue, kernel, w, h, events);
+	queue.enqueueNDRangeKernel(kernel, offset, local.getGlobal(w, h), local.getLocal(), events, event);
+}
+
+////////////////////////////////////////////////////////////////////////
+LocalSize WorkGroupTuner::tune(cl::CommandQueue& queue, cl::Kernel& kernel, const cl::Device& dev, size_t w, size_t h, map<string, double>& times) {
+	const size_t maxSize = min(dev.getInfo<CL_DEVICE_MAX_WORK_GROUP_SIZE>(), kernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(dev));
+	const size_t multiple = max<size_t>(kernel.getWorkGroupInfo<CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE>(dev), 1);
+	const vector<size_t> maxItems = dev.getInfo<CL_DEVICE_MAX_WORK_ITEM_SIZES>();
+	const bool profiling = (queue.getInfo<CL_QUEUE_PROPERTIES>() & CL_QUEUE_PROFILING_ENABLE) != 0;
+
+	// candidates: the driver's choice and powers of two not larger than the rounded problem
+	vector<LocalSize> candidates(1);
+	for(size_t x = 1; x <= maxSize && x <= nextPowerOfTwo(w) && x <= maxItems[0]; x *= 2) {
+		for(size_t y = 1; x*y <= maxSize && y <= nextPowerOfTwo(h) && y <= maxItems[1]; y *= 2) {
+			if ((x*y)%multiple == 0) {
+				LocalSize l;
+				l.m_x = x;
+				l.m_y = y;
+				candidates.push_back(l);
+			}
+		}
+	}
+
+	// warm-up with the driver's choice, then one run per candidate
+	Stopwatch sw;
+	LocalSize best;
+	double bestTime = 0;
+
+	queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(w, h), cl::NullRange);
+	queue.finish();
+	for(const LocalSize& l: candidates) {
+		cl::Event event;
+		double t;
+
+		try {
+			sw.Start();
+			queue.enqueueNDRangeKernel(kernel, cl::NullRange, l.getGlobal(w, h), l.getLocal(), nullptr, &event);
+			event.wait();
+			sw.Stop();
+			t = profiling ? (event.getProfilingInfo<CL_PROFILING_COMMAND_END>() - event.getProfilingInfo<CL_PROFILING_COMMAND_START>())*1e-6 : sw.GetElapsedTimeMilliseconds();
+		} catch(cl::Error&) {
+			// local size not accepted, e.g. because of the resources of the kernel
+			continue;
+		}
+		times[l.getName()] = t;
+		if (times.size() == 1 || t < bestTime) {
+			best = l;
+			bestTime = t;
+		}
+	}
+	cout << "Work-group tuning of " << key(dev, kernel, w, h) << ": " << best.getName() << " in " << bestTime << " ms, driver's choice " << times["driver"] << " ms" << endl;
+	return best;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool WorkGroupTuner::load() {
+	ifstream file(m_fileName);
+	string line;
+
+	if (!file) return false;
+	while(getline(file, line)) {
+		const size_t tab = line.rfind('\t');
+		if (tab == string::npos) continue;
+
+		// value: "driver" or local size "<x>x<y>"
+		const string value = line.substr(tab + 1);
+		istringstream is(value);
+		LocalSize l;
+		char sep = 0;
+		if (value == "driver" || (is >> l.m_x >> sep >> l.m_y && sep == 'x')) m_decisions[line.substr(0, tab)] = l;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool WorkGroupTuner::save() const {
+	ofstream file(m_fileName, ios::trunc);
+
+	for(const auto& d: m_decisions) file << d.first << '\t' << d.second.getName() << endl;
+	return file.good();
+}
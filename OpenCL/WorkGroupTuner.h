@@ -0,0 +1,60 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ProgramCache.h"
+
+////////////////////////////////////////////////////////////////////////
+// Local work-group size of a 2D kernel; 0 x 0 leaves the choice to the driver (cl::NullRange)
+struct LocalSize {
+	size_t m_x = 0;
+	size_t m_y = 0;
+
+	bool isDriverChoice() const { return m_x == 0; }
+	cl::NDRange getLocal() const { return isDriverChoice() ? cl::NullRange : cl::NDRange(m_x, m_y); }
+	// global range padded to multiples of the local size: the kernels must ignore the work-items outside w x h
+	cl::NDRange getGlobal(size_t w, size_t h) const;
+	std::string getName() const;
+};
+
+////////////////////////////////////////////////////////////////////////
+// Auto-tuner of the local work-group size per device, kernel and problem size. On first use of a combination all
+// local sizes within CL_DEVICE_MAX_WORK_GROUP_SIZE and CL_KERNEL_WORK_GROUP_SIZE whose work-group size is a
+// multiple of CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE are timed once, together with the driver's choice.
+// Problem sizes are rounded up to powers of two, so bands and matrices of similar size share their tuning.
+// The decisions are saved after each tuning and loaded again by the next process.
+class WorkGroupTuner {
+	std::string m_fileName;
+	std::map<std::string, LocalSize> m_decisions;
+	std::map<std::string, double> m_times;		// ms of the local sizes of the last tuning
+	std::mutex m_mutex;							// the co-execution enqueues from several threads
+
+	std::string key(const cl::Device& dev, const cl::Kernel& kernel, size_t w, size_t h) const;
+	LocalSize tune(cl::CommandQueue& queue, cl::Kernel& kernel, const cl::Device& dev, size_t w, size_t h, std::map<std::string, double>& times);
+
+public:
+	explicit WorkGroupTuner(const char* fileName);
+	WorkGroupTuner(const WorkGroupTuner&) = delete;
+	WorkGroupTuner& operator=(const WorkGroupTuner&) = delete;
+
+	// tuner of the process, its decisions are kept in workgroups.txt
+	static WorkGroupTuner& get();
+
+	// local size of the kernel for w x h work-items, tuned on the queue if there is no decision yet;
+	// the kernel arguments must be set, tuning waits for the events and runs the kernel several times
+	LocalSize select(cl::CommandQueue& queue, cl::Kernel& kernel, size_t w, size_t h, const std::vector<cl::Event>* events = nullptr);
+	// enqueues the kernel over w x h work-items with the selected local size and the padded global range;
+	// the kernel waits for the events
+	void enqueue(cl::CommandQueue& queue, cl::Kernel& kernel, size_t w, size_t h, const std::vector<cl::Event>* events = nullptr, cl::Event* event = nullptr);
+	// same with the global work offset of the work-items, e.g. the first row of a band
+	void enqueue(cl::CommandQueue& queue, cl::Kernel& kernel, const cl::NDRange& offset, size_t w, size_t h, const std::vector<cl::Event>* events = nullptr, cl::Event* event = nullptr);
+
+	// decisions of previous runs: one line per decision with key and local size separated by a tab
+	bool load();
+	bool save() const;
+
+	size_t getDecisions() const { return m_decisions.size(); }
+	const std::map<std::string, double>& getTimes() const { return m_times; }
+};